@@ -0,0 +1,138 @@
+#ifndef SEQUENCE_ARRAY_H
+#define SEQUENCE_ARRAY_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+// Ленивый массив-арифметическая прогрессия: (start + i * step) * multiplier.
+// Хранит четыре числа вместо n элементов. Сумма, доступ по индексу, обратный
+// обход и умножение на k работают за O(1) памяти и времени (обход — O(1) на шаг).
+// Элементы выделяются в памяти только при первой записи через set().
+class SequenceArray {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = long long;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = long long;  // элементы вычисляются, ссылку вернуть не на что
+
+        const_iterator(const SequenceArray* array, size_t index) : array(array), index(index) {}
+
+        long long operator*() const { return (*array)[index]; }
+        const_iterator& operator++() { ++index; return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++index; return old; }
+        const_iterator& operator--() { --index; return *this; }
+        const_iterator operator--(int) { const_iterator old = *this; --index; return old; }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+
+    private:
+        const SequenceArray* array;
+        size_t index;
+    };
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    SequenceArray(long long start, long long step, size_t count, long long multiplier = 1)
+        : start(start), step(step), count(count), multiplier(multiplier) {}
+
+    size_t size() const { return count; }
+    bool isMaterialized() const { return materialized; }
+
+    // Элемент вычисляется с той же проверкой переполнения, что и sum()
+    long long operator[](size_t i) const {
+        if (materialized) {
+            return data[i];
+        }
+        return checkedMul(checkedAdd(start, checkedMul(static_cast<long long>(i), step)), multiplier);
+    }
+
+    long long at(size_t i) const {
+        if (i >= count) {
+            throw std::out_of_range("Индекс за пределами последовательности!");
+        }
+        return (*this)[i];
+    }
+
+    // Сумма по формуле n * start + step * n(n-1)/2, умноженная на multiplier.
+    // Переполнение long long проверяется, а не молча заворачивается.
+    long long sum() const {
+        if (materialized) {
+            long long total = 0;
+            for (long long value : data) {
+                total = checkedAdd(total, value);
+            }
+            return total;
+        }
+        long long n = static_cast<long long>(count);
+        // Из n и n - 1 чётно одно: делим его, чтобы не переполнить произведение
+        long long pairs = (n % 2 == 0) ? checkedMul(n / 2, n - 1) : checkedMul(n, (n - 1) / 2);
+        long long base = checkedAdd(checkedMul(n, start), checkedMul(step, pairs));
+        return checkedMul(base, multiplier);
+    }
+
+    void multiply(long long k) {
+        if (materialized) {
+            for (long long& value : data) {
+                value = checkedMul(value, k);
+            }
+        } else {
+            multiplier = checkedMul(multiplier, k);
+        }
+    }
+
+    // Запись элемента: прогрессия перестаёт быть прогрессией, поэтому
+    // только здесь элементы выделяются в памяти
+    void set(size_t i, long long value) {
+        if (i >= count) {
+            throw std::out_of_range("Индекс за пределами последовательности!");
+        }
+        materialize();
+        data[i] = value;
+    }
+
+    void materialize() {
+        if (materialized) {
+            return;
+        }
+        data.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            data.push_back((*this)[i]);
+        }
+        materialized = true;
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+private:
+    static long long checkedMul(long long a, long long b) {
+        long long result;
+        if (__builtin_mul_overflow(a, b, &result)) {
+            throw std::overflow_error("Значение не помещается в long long!");
+        }
+        return result;
+    }
+
+    static long long checkedAdd(long long a, long long b) {
+        long long result;
+        if (__builtin_add_overflow(a, b, &result)) {
+            throw std::overflow_error("Значение не помещается в long long!");
+        }
+        return result;
+    }
+
+    long long start;
+    long long step;
+    size_t count;
+    long long multiplier;
+    bool materialized = false;
+    std::vector<long long> data;
+};
+
+#endif // SEQUENCE_ARRAY_H
@@ -1,7 +1,10 @@
 #include <iostream>
+#include <charconv>
+#include <string>
 #include <vector>
 #include <stack>
 #include <stdexcept>
+#include "SequenceArray.h"
 
 // Функция для создания вектора с числами от 1 до n (с проверкой)
 std::vector<int> createArray(int n) {
@@ -17,24 +20,37 @@ std::vector<int> createArray(int n) {
 }
 
 // Функция для подсчёта суммы элементов вектора
-int calculateSum(const std::vector<int>& arr) {
-    int sum = 0;
+long long calculateSum(const std::vector<int>& arr) {
+    long long sum = 0;
     for (int num : arr) {
         sum += num;
     }
     return sum;
 }
 
-// Форматированный вывод чисел
+// Сумма прогрессии — по формуле, без обхода элементов
+long long calculateSum(const SequenceArray& sequence) {
+    return sequence.sum();
+}
+
+// Форматированный вывод чисел: строка собирается в буфере через std::to_chars
+// и выводится одним write, без вызова operator<< на каждый элемент
 void printFormatted(const std::string& message, const std::vector<int>& arr) {
-    std::cout << message;
+    const size_t maxNumberLength = 11; // "-2147483648"
+    std::string buffer;
+    buffer.reserve(message.size() + arr.size() * (maxNumberLength + 2) + 1);
+    buffer += message;
+
+    char number[maxNumberLength];
     for (size_t i = 0; i < arr.size(); ++i) {
-        std::cout << arr[i];
+        char* end = std::to_chars(number, number + maxNumberLength, arr[i]).ptr;
+        buffer.append(number, end);
         if (i != arr.size() - 1) {
-            std::cout << ", ";
+            buffer += ", ";
         }
     }
-    std::cout << std::endl;
+    buffer += '\n';
+    std::cout.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
 }
 
 // Вывод в обратном порядке через reverse-итераторы
@@ -75,6 +91,25 @@ void printAndModifyViaPointers(std::vector<int>& arr) {
     printFormatted("", arr);
 }
 
+// Больше элементов поэлементно не выводится: массив 1..n описывается
+// прогрессией, и для больших n выделять память под него незачем
+const int PRINT_LIMIT = 1000;
+const size_t PREVIEW_COUNT = 5;
+
+// Начало и конец последовательности, обход конца — обратными итераторами
+void printSequencePreview(const SequenceArray& sequence) {
+    std::cout << "Первые элементы: ";
+    for (size_t i = 0; i < PREVIEW_COUNT; ++i) {
+        std::cout << sequence[i] << " ";
+    }
+    std::cout << "\nОбратный порядок (через итераторы, начало): ";
+    auto it = sequence.rbegin();
+    for (size_t i = 0; i < PREVIEW_COUNT; ++i, ++it) {
+        std::cout << *it << " ";
+    }
+    std::cout << std::endl;
+}
+
 int main() {
     try {
         int n;
@@ -85,14 +120,26 @@ int main() {
             throw std::invalid_argument("Ошибка: n должно быть положительным числом!");
         }
 
-        std::vector<int> numbers = createArray(n);
-        printFormatted("Исходный массив: ", numbers);
+        long long sum;
+        if (n <= PRINT_LIMIT) {
+            std::vector<int> numbers = createArray(n);
+            printFormatted("Исходный массив: ", numbers);
 
-        printReverse(numbers);
-        printReverseStack(numbers);
-        printAndModifyViaPointers(numbers);
+            printReverse(numbers);
+            printReverseStack(numbers);
+            printAndModifyViaPointers(numbers);
+            // Сумма того массива, который только что выведен и изменён
+            sum = calculateSum(numbers);
+        } else {
+            // Массив 1..n: прогрессия с началом 1 и шагом 1
+            SequenceArray sequence(1, 1, static_cast<size_t>(n));
+            std::cout << "Массив из " << n << " элементов не выводится целиком и не хранится в памяти" << std::endl;
+            printSequencePreview(sequence);
 
-        int sum = calculateSum(numbers);
+            // Умножение на 2 повторяет модификацию через указатели: O(1) для прогрессии
+            sequence.multiply(2);
+            sum = calculateSum(sequence);
+        }
         std::cout << "Сумма всех чисел: " << sum << std::endl;
 
     } catch (const std::exception& e) {
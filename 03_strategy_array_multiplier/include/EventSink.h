@@ -0,0 +1,29 @@
+#ifndef EVENT_SINK_H
+#define EVENT_SINK_H
+
+#include <iostream>
+#include <string>
+
+// Приёмник сообщений контекста. ArrayMultiplier сам ничего не печатает:
+// о смене стратегии он сообщает приёмнику, а тот решает, как это показать.
+class EventSink {
+public:
+    virtual ~EventSink() = default;
+    virtual void strategyApplied(const std::string& strategyName) = 0;
+};
+
+// Сообщения в консоль
+class ConsoleEventSink : public EventSink {
+public:
+    void strategyApplied(const std::string& strategyName) override {
+        std::cout << "✓ Применена стратегия: " << strategyName << "\n";
+    }
+};
+
+// Без сообщений: например, при замерах времени
+class NullEventSink : public EventSink {
+public:
+    void strategyApplied(const std::string&) override {}
+};
+
+#endif // EVENT_SINK_H
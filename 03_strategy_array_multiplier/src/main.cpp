@@ -31,10 +31,14 @@ std::string PointerMultiplication::getName() const {
 }
 
 // Реализация ArrayMultiplier
+void ArrayMultiplier::setEventSink(EventSink* sink) {
+    events = sink;
+}
+
 void ArrayMultiplier::setStrategy(std::unique_ptr<MultiplicationStrategy> newStrategy) {
     strategy = std::move(newStrategy);
-    if (strategy) {
-        std::cout << "✓ Применена стратегия: " << strategy->getName() << std::endl;
+    if (strategy && events) {
+        events->strategyApplied(strategy->getName());
     }
 }
 
@@ -107,7 +111,9 @@ int main() {
             throw std::runtime_error("Ошибка выбора стратегии");
         }
         
+        ConsoleEventSink console;
         ArrayMultiplier multiplier;
+        multiplier.setEventSink(&console);
         
         switch (choice) {
             case 1:
@@ -0,0 +1,29 @@
+#ifndef EVENT_SINK_H
+#define EVENT_SINK_H
+
+#include <iostream>
+#include <string>
+
+// Приёмник сообщений контекста. Стратегии только умножают и ничего
+// не печатают; о том, какая стратегия применяется, сообщает ArrayMultiplier.
+class EventSink {
+public:
+    virtual ~EventSink() = default;
+    virtual void strategyApplied(const std::string& strategyName) = 0;
+};
+
+// Сообщения в консоль
+class ConsoleEventSink : public EventSink {
+public:
+    void strategyApplied(const std::string& strategyName) override {
+        std::cout << "Применяется стратегия: " << strategyName << std::endl;
+    }
+};
+
+// Без сообщений: например, при замерах времени
+class NullEventSink : public EventSink {
+public:
+    void strategyApplied(const std::string&) override {}
+};
+
+#endif // EVENT_SINK_H
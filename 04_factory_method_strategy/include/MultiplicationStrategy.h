@@ -4,6 +4,7 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include "EventSink.h"
 
 // Базовый интерфейс стратегии
 class MultiplicationStrategy {
@@ -38,8 +39,10 @@ public:
 class ArrayMultiplier {
 private:
     std::unique_ptr<MultiplicationStrategy> strategy;
+    EventSink* events = nullptr;  // nullptr — без сообщений
     
 public:
+    void setEventSink(EventSink* sink);
     void setStrategy(std::unique_ptr<MultiplicationStrategy> newStrategy);
     void multiplyArray(std::vector<int>& arr, int k);
     bool hasStrategy() const;
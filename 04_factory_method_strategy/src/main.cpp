@@ -7,7 +7,6 @@
 
 // Реализация LoopMultiplication
 void LoopMultiplication::multiply(std::vector<int>& arr, int k) {
-    std::cout << "Применяется стратегия: " << getName() << std::endl;
     for (size_t i = 0; i < arr.size(); i++) {
         arr[i] *= k;
     }
@@ -19,7 +18,6 @@ std::string LoopMultiplication::getName() const {
 
 // Реализация PointerMultiplication
 void PointerMultiplication::multiply(std::vector<int>& arr, int k) {
-    std::cout << "Применяется стратегия: " << getName() << std::endl;
     int* ptr = arr.data();
     int* end = ptr + arr.size();
     
@@ -35,7 +33,6 @@ std::string PointerMultiplication::getName() const {
 
 // Реализация STLMultiplication
 void STLMultiplication::multiply(std::vector<int>& arr, int k) {
-    std::cout << "Применяется стратегия: " << getName() << std::endl;
     for (auto& element : arr) {
         element *= k;
     }
@@ -46,12 +43,19 @@ std::string STLMultiplication::getName() const {
 }
 
 // Реализация ArrayMultiplier
+void ArrayMultiplier::setEventSink(EventSink* sink) {
+    events = sink;
+}
+
 void ArrayMultiplier::setStrategy(std::unique_ptr<MultiplicationStrategy> newStrategy) {
     strategy = std::move(newStrategy);
 }
 
 void ArrayMultiplier::multiplyArray(std::vector<int>& arr, int k) {
     if (strategy) {
+        if (events) {
+            events->strategyApplied(strategy->getName());
+        }
         strategy->multiply(arr, k);
     } else {
         throw std::runtime_error("Стратегия не установлена!");
@@ -145,7 +149,9 @@ int main() {
         // Создание стратегии через фабрику
         auto strategy = StrategyFactory::create(static_cast<StrategyFactory::StrategyType>(choice));
         
+        ConsoleEventSink console;
         ArrayMultiplier multiplier;
+        multiplier.setEventSink(&console);
         multiplier.setStrategy(std::move(strategy));
         
         // Вывод исходного массива и суммы
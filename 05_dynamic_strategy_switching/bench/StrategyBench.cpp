@@ -0,0 +1,530 @@
+// Бенчмарк стратегий умножения: все StrategyFactory::StrategyType на размерах
+// от умещающихся в L1 до многократно превышающих последний уровень кэша.
+//
+// Запуск: ./strategy_bench [--min-size N] [--max-size N] [--reps N] [--warmup N]
+//                          [--cpu N] [--json путь]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+#include "MultiplicationStrategy.h"
+#include "StrategyFactory.h"
+#include "ThreadPool.h"
+#include "SimdKernels.h"
+#include "StaticArrayMultiplier.h"
+#include "BatchMultiplier.h"
+#include "OperationPipeline.h"
+
+namespace {
+
+struct BenchOptions {
+    size_t minSize = 0;   // 0 — выбрать по размеру L1
+    size_t maxSize = 0;   // 0 — выбрать по размеру LLC
+    int repetitions = 10;
+    int warmup = 2;
+    int cpu = -1;         // -1 — без привязки к ядру
+    std::string jsonPath = "strategy_bench.json";
+};
+
+struct BenchResult {
+    std::string strategy;
+    int type;
+    size_t size;
+    size_t innerIterations;
+    double nsPerElement;     // медиана
+    double minNsPerElement;
+    double stddevNs;
+    double gbPerSecond;      // по медиане: чтение + запись каждого элемента
+};
+
+size_t cacheSize(int name, size_t fallback) {
+    long value = sysconf(name);
+    return value > 0 ? static_cast<size_t>(value) : fallback;
+}
+
+size_t parseSize(const char* text) {
+    char* end = nullptr;
+    unsigned long long value = std::strtoull(text, &end, 10);
+    if (end == text || *end != '\0' || value == 0) {
+        throw std::invalid_argument(std::string("Неверное число: ") + text);
+    }
+    return static_cast<size_t>(value);
+}
+
+BenchOptions parseOptions(int argc, char** argv) {
+    BenchOptions options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Не указано значение для " + arg);
+        }
+        const char* value = argv[++i];
+        if (arg == "--min-size") {
+            options.minSize = parseSize(value);
+        } else if (arg == "--max-size") {
+            options.maxSize = parseSize(value);
+        } else if (arg == "--reps") {
+            options.repetitions = static_cast<int>(parseSize(value));
+        } else if (arg == "--warmup") {
+            options.warmup = std::atoi(value);
+        } else if (arg == "--cpu") {
+            options.cpu = std::atoi(value);
+        } else if (arg == "--json") {
+            options.jsonPath = value;
+        } else {
+            throw std::invalid_argument("Неизвестный параметр: " + arg);
+        }
+    }
+    return options;
+}
+
+// Поток замеров привязывается к ядру cpu, потоки пула — к следующим ядрам
+// по кругу. Без этого параллельная стратегия работала бы на плавающих
+// потоках и её замеры не были бы воспроизводимы.
+void pinToCpu(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        throw std::runtime_error("Не удалось привязать поток к ядру " + std::to_string(cpu));
+    }
+    ThreadPool& pool = ThreadPool::instance();
+    int cpus = std::max(1, static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN)));
+    for (size_t i = 0; i < pool.size(); i++) {
+        int workerCpu = (cpu + 1 + static_cast<int>(i)) % cpus;
+        if (!pool.pinWorker(i, workerCpu)) {
+            throw std::runtime_error("Не удалось привязать поток пула к ядру " + std::to_string(workerCpu));
+        }
+    }
+#else
+    (void)cpu;
+    std::cerr << "Привязка к ядру не поддерживается на этой платформе" << std::endl;
+#endif
+}
+
+// Маленькие массивы повторяются внутри одного замера, чтобы замер длился
+// заметно дольше разрешения часов
+size_t innerIterationsFor(size_t size) {
+    const size_t elementsPerSample = size_t{1} << 22;
+    return std::max<size_t>(1, elementsPerSample / size);
+}
+
+BenchResult measure(MultiplicationStrategy& strategy, int type, size_t size, const BenchOptions& options) {
+    // Замеряется путь ArrayMultiplier: multiplyWithSum с нечастным k = 3
+    // (k = -1 и степени двойки до стратегии не доходят). Переполнение при
+    // повторах безопасно: умножение идёт по модулю 2^32.
+    std::vector<int> arr(size);
+    for (size_t i = 0; i < size; i++) {
+        arr[i] = static_cast<int>(i % 1000) - 500;
+    }
+
+    size_t inner = innerIterationsFor(size);
+    auto runSample = [&] {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t it = 0; it < inner; it++) {
+            strategy.multiplyWithSum(arr, 3, nullptr);
+        }
+        auto stop = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+        return ns / static_cast<double>(size * inner);
+    };
+
+    for (int i = 0; i < options.warmup; i++) {
+        runSample();
+    }
+    std::vector<double> samples;
+    samples.reserve(options.repetitions);
+    for (int i = 0; i < options.repetitions; i++) {
+        samples.push_back(runSample());
+    }
+
+    double mean = 0;
+    for (double sample : samples) {
+        mean += sample;
+    }
+    mean /= samples.size();
+    double variance = 0;
+    for (double sample : samples) {
+        variance += (sample - mean) * (sample - mean);
+    }
+    variance /= samples.size();
+
+    std::sort(samples.begin(), samples.end());
+    double median = samples[samples.size() / 2];
+
+    BenchResult result;
+    result.strategy = strategy.getName();
+    result.type = type;
+    result.size = size;
+    result.innerIterations = inner;
+    result.nsPerElement = median;
+    result.minNsPerElement = samples.front();
+    result.stddevNs = std::sqrt(variance);
+    result.gbPerSecond = 2.0 * sizeof(int) / median;
+    return result;
+}
+
+// Стоимость вызова на коротких массивах: виртуальный вызов через
+// MultiplicationStrategy против StaticArrayMultiplier с той же стратегией
+struct DispatchResult {
+    size_t size;
+    double virtualNsPerCall;
+    double staticNsPerCall;
+};
+
+const size_t DISPATCH_SIZES[] = {4, 16, 64};
+const size_t DISPATCH_CALLS = size_t{1} << 22;
+
+template <typename Call>
+double nsPerCall(std::vector<int>& arr, const BenchOptions& options, Call call) {
+    auto runSample = [&] {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < DISPATCH_CALLS; i++) {
+            call(arr);
+            // Не даёт компилятору объединить повторные умножения
+            asm volatile("" : : "r"(arr.data()) : "memory");
+        }
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count() / DISPATCH_CALLS;
+    };
+    for (int i = 0; i < options.warmup; i++) {
+        runSample();
+    }
+    std::vector<double> samples;
+    for (int i = 0; i < options.repetitions; i++) {
+        samples.push_back(runSample());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+DispatchResult measureDispatch(size_t size, const BenchOptions& options) {
+    // Нули и k = 3: умножение не переполняется, и StaticArrayMultiplier
+    // не уходит в частный случай для k = -1 (SpecialMultipliers.h)
+    std::vector<int> arr(size, 0);
+    std::unique_ptr<MultiplicationStrategy> dynamic = StrategyFactory::create(StrategyFactory::LOOP);
+    StaticArrayMultiplier<LoopMultiplication, PointerMultiplication, SimdMultiplication> fixed;
+
+    DispatchResult result;
+    result.size = size;
+    result.virtualNsPerCall = nsPerCall(arr, options, [&](std::vector<int>& a) { dynamic->multiply(a, 3); });
+    result.staticNsPerCall = nsPerCall(arr, options, [&](std::vector<int>& a) { fixed.multiplyArray(a, 3); });
+    return result;
+}
+
+// Пакет массивов с сильным перекосом размеров: в основном короткие
+// (16–512 элементов) и изредка длинные (64K–1M). Сравнивается обработка
+// по одному массиву в вызывающем потоке и multiplyBatch.
+struct BatchResult {
+    size_t jobs;
+    size_t elements;
+    double sequentialMs;
+    double batchMs;
+    BatchStats stats;
+};
+
+const size_t BATCH_JOBS = 4000;
+
+BatchResult measureBatch(const BenchOptions& options) {
+    // Детерминированный генератор: одинаковый пакет в каждом запуске
+    uint64_t state = 88172645463325252ull;
+    auto next = [&state] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+
+    std::vector<std::vector<int>> arrays(BATCH_JOBS);
+    for (auto& arr : arrays) {
+        size_t size = next() % 20 == 0 ? (size_t{1} << 16) + next() % (size_t{1} << 20)
+                                       : 16 + next() % 497;
+        arr.assign(size, 1);
+    }
+    std::unique_ptr<MultiplicationStrategy> strategy = StrategyFactory::create(StrategyFactory::SIMD);
+    std::vector<BatchJob> jobs;
+    for (auto& arr : arrays) {
+        // k = 3, а не -1: смену знака multiplyBatch выполнил бы без стратегии
+        jobs.push_back({arr, 3, strategy.get()});
+    }
+
+    BatchResult result{};
+    result.jobs = jobs.size();
+    auto median = [&](auto run) {
+        for (int i = 0; i < options.warmup; i++) {
+            run();
+        }
+        std::vector<double> samples;
+        for (int i = 0; i < options.repetitions; i++) {
+            auto start = std::chrono::steady_clock::now();
+            run();
+            auto stop = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    };
+    result.sequentialMs = median([&] {
+        for (const BatchJob& job : jobs) {
+            job.strategy->multiply(job.array, job.k);
+        }
+    });
+    result.batchMs = median([&] { result.stats = multiplyBatch(jobs); });
+    result.elements = result.stats.elements;
+    return result;
+}
+
+// Цепочка «умножить, прибавить, развернуть, сумма»: четыре отдельных прохода
+// (стратегия SIMD, цикл, std::reverse, std::accumulate) против одного
+// прохода конвейера из OperationPipeline.h
+struct FusedResult {
+    size_t size;
+    double separateNsPerElement;
+    double fusedNsPerElement;
+};
+
+const size_t FUSED_SIZES[] = {size_t{1} << 14, size_t{1} << 24};
+
+FusedResult measureFused(size_t size, const BenchOptions& options) {
+    std::vector<int> arr(size, 1);
+    std::unique_ptr<MultiplicationStrategy> simd = StrategyFactory::create(StrategyFactory::SIMD);
+    auto plan = pipeline::multiply(-1) | pipeline::add(1) | pipeline::reverse() | pipeline::sum();
+    long long sink = 0;
+
+    auto nsPerElement = [&](auto run) {
+        size_t inner = innerIterationsFor(size);
+        for (int i = 0; i < options.warmup; i++) {
+            run();
+        }
+        std::vector<double> samples;
+        for (int i = 0; i < options.repetitions; i++) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t j = 0; j < inner; j++) {
+                run();
+            }
+            auto stop = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration<double, std::nano>(stop - start).count() / (inner * size));
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    };
+
+    FusedResult result;
+    result.size = size;
+    result.separateNsPerElement = nsPerElement([&] {
+        simd->multiply(arr, -1);
+        for (int& value : arr) {
+            value += 1;
+        }
+        std::reverse(arr.begin(), arr.end());
+        sink += std::accumulate(arr.begin(), arr.end(), 0LL);
+    });
+    result.fusedNsPerElement = nsPerElement([&] { sink += plan.run(arr); });
+    // Результат используется, чтобы проходы не были выброшены как мёртвый код
+    asm volatile("" : : "r"(sink));
+    return result;
+}
+
+std::string formatBytes(size_t bytes) {
+    const char* units[] = {"B", "KiB", "MiB", "GiB"};
+    int unit = 0;
+    double value = static_cast<double>(bytes);
+    while (value >= 1024 && unit < 3) {
+        value /= 1024;
+        unit++;
+    }
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(value < 10 ? 1 : 0) << value << " " << units[unit];
+    return out.str();
+}
+
+// Выравнивание по числу символов UTF-8, а не байт (std::setw считает байты)
+std::string pad(const std::string& text, size_t width, bool alignLeft) {
+    size_t length = 0;
+    for (unsigned char c : text) {
+        if ((c & 0xC0) != 0x80) {
+            length++;
+        }
+    }
+    std::string padding(length < width ? width - length : 0, ' ');
+    return alignLeft ? text + padding : padding + text;
+}
+
+std::string escapeJson(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+void writeJson(const std::string& path, const BenchOptions& options, size_t l1, size_t llc,
+               const std::vector<BenchResult>& results, const std::vector<DispatchResult>& dispatch,
+               const BatchResult& batch, const std::vector<FusedResult>& fused) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Не удалось открыть " + path);
+    }
+    out << "{\n";
+    out << "  \"simd\": \"" << simdInstructionSet() << "\",\n";
+    out << "  \"threads\": " << ThreadPool::instance().size() + 1 << ",\n";
+    out << "  \"l1_bytes\": " << l1 << ",\n";
+    out << "  \"llc_bytes\": " << llc << ",\n";
+    out << "  \"repetitions\": " << options.repetitions << ",\n";
+    out << "  \"warmup\": " << options.warmup << ",\n";
+    out << "  \"cpu\": " << options.cpu << ",\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& r = results[i];
+        out << "    {\"type\": " << r.type
+            << ", \"strategy\": \"" << escapeJson(r.strategy) << "\""
+            << ", \"elements\": " << r.size
+            << ", \"bytes\": " << r.size * sizeof(int)
+            << ", \"inner_iterations\": " << r.innerIterations
+            << ", \"ns_per_element\": " << r.nsPerElement
+            << ", \"min_ns_per_element\": " << r.minNsPerElement
+            << ", \"stddev_ns_per_element\": " << r.stddevNs
+            << ", \"gb_per_second\": " << r.gbPerSecond << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n";
+    out << "  \"dispatch\": [\n";
+    for (size_t i = 0; i < dispatch.size(); i++) {
+        const auto& d = dispatch[i];
+        out << "    {\"elements\": " << d.size
+            << ", \"virtual_ns_per_call\": " << d.virtualNsPerCall
+            << ", \"static_ns_per_call\": " << d.staticNsPerCall << "}"
+            << (i + 1 < dispatch.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n";
+    out << "  \"batch\": {\"jobs\": " << batch.jobs
+        << ", \"elements\": " << batch.elements
+        << ", \"tasks\": " << batch.stats.tasks
+        << ", \"split_jobs\": " << batch.stats.splitJobs
+        << ", \"steals\": " << batch.stats.steals
+        << ", \"sequential_ms\": " << batch.sequentialMs
+        << ", \"batch_ms\": " << batch.batchMs << "},\n";
+    out << "  \"fused\": [\n";
+    for (size_t i = 0; i < fused.size(); i++) {
+        const auto& f = fused[i];
+        out << "    {\"elements\": " << f.size
+            << ", \"separate_ns_per_element\": " << f.separateNsPerElement
+            << ", \"fused_ns_per_element\": " << f.fusedNsPerElement << "}"
+            << (i + 1 < fused.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        BenchOptions options = parseOptions(argc, argv);
+
+        size_t l1 = cacheSize(_SC_LEVEL1_DCACHE_SIZE, 32 * 1024);
+        size_t llc = cacheSize(_SC_LEVEL3_CACHE_SIZE, 0);
+        if (llc == 0) {
+            llc = cacheSize(_SC_LEVEL2_CACHE_SIZE, 8 * 1024 * 1024);
+        }
+        if (options.minSize == 0) {
+            options.minSize = l1 / 2 / sizeof(int);
+        }
+        if (options.maxSize == 0) {
+            // 16 × LLC, но не больше четверти физической памяти
+            size_t memory = static_cast<size_t>(sysconf(_SC_PHYS_PAGES)) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            options.maxSize = std::min(llc * 16, memory / 4) / sizeof(int);
+        }
+
+        // Пул создаётся до привязки: иначе все его потоки унаследуют одно ядро
+        ThreadPool::instance();
+        if (options.cpu >= 0) {
+            pinToCpu(options.cpu);
+        }
+
+        std::cout << "=== БЕНЧМАРК СТРАТЕГИЙ УМНОЖЕНИЯ ===" << "\n";
+        std::cout << "L1d: " << formatBytes(l1) << ", LLC: " << formatBytes(llc)
+                  << ", SIMD: " << simdInstructionSet()
+                  << ", потоков: " << ThreadPool::instance().size() + 1
+                  << ", повторов: " << options.repetitions
+                  << ", прогрев: " << options.warmup << "\n\n";
+        std::cout << pad("Размер", 12, true) << pad("Тип", 6, true)
+                  << pad("нс/элем", 12, false) << pad("мин", 12, false)
+                  << pad("σ, %", 10, false) << pad("ГБ/с", 10, false) << "  Стратегия\n";
+
+        std::vector<BenchResult> results;
+        for (size_t size = options.minSize; size <= options.maxSize; size *= 4) {
+            for (auto type : StrategyFactory::allTypes()) {
+                auto strategy = StrategyFactory::create(type);
+                BenchResult r = measure(*strategy, type, size, options);
+                results.push_back(r);
+
+                std::cout << pad(formatBytes(size * sizeof(int)), 12, true)
+                          << pad(std::to_string(type), 6, true) << std::fixed
+                          << std::setw(12) << std::setprecision(3) << r.nsPerElement
+                          << std::setw(12) << r.minNsPerElement
+                          << std::setw(10) << std::setprecision(1) << 100.0 * r.stddevNs / r.nsPerElement
+                          << std::setw(10) << std::setprecision(2) << r.gbPerSecond
+                          << "  " << r.strategy << "\n";
+            }
+            std::cout << std::flush;
+        }
+
+        std::cout << "\nДиспетчеризация на коротких массивах (умножение через цикл):\n";
+        std::cout << pad("Элементов", 12, true) << pad("virtual, нс", 14, false)
+                  << pad("variant, нс", 14, false) << "\n";
+        std::vector<DispatchResult> dispatch;
+        for (size_t size : DISPATCH_SIZES) {
+            DispatchResult d = measureDispatch(size, options);
+            dispatch.push_back(d);
+            std::cout << pad(std::to_string(size), 12, true) << std::fixed << std::setprecision(2)
+                      << std::setw(14) << d.virtualNsPerCall << std::setw(14) << d.staticNsPerCall << "\n";
+        }
+
+        BatchResult batch = measureBatch(options);
+        std::cout << "\nПакет из " << batch.jobs << " массивов (" << batch.elements << " элементов, задач: "
+                  << batch.stats.tasks << ", разбито: " << batch.stats.splitJobs
+                  << ", украдено: " << batch.stats.steals << "):\n"
+                  << std::setprecision(3) << "  по одному: " << batch.sequentialMs << " мс, multiplyBatch: "
+                  << batch.batchMs << " мс\n";
+
+        std::cout << "\nУмножить, прибавить, развернуть, сумма (нс/элемент):\n";
+        std::cout << pad("Размер", 12, true) << pad("4 прохода", 14, false)
+                  << pad("конвейер", 14, false) << "\n";
+        std::vector<FusedResult> fused;
+        for (size_t size : FUSED_SIZES) {
+            FusedResult f = measureFused(size, options);
+            fused.push_back(f);
+            std::cout << pad(formatBytes(size * sizeof(int)), 12, true) << std::setprecision(3)
+                      << std::setw(14) << f.separateNsPerElement << std::setw(14) << f.fusedNsPerElement << "\n";
+        }
+
+        writeJson(options.jsonPath, options, l1, llc, results, dispatch, batch, fused);
+        std::cout << "\nРезультаты в JSON: " << options.jsonPath << std::endl;
+
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Ошибка: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
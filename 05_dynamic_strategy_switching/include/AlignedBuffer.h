@@ -0,0 +1,83 @@
+#ifndef ALIGNED_BUFFER_H
+#define ALIGNED_BUFFER_H
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "ArrayView.h"
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+constexpr size_t HUGE_PAGE_SIZE = size_t{2} << 20;
+
+// Параметры выделения выровненной памяти
+struct BufferOptions {
+    size_t alignment = CACHE_LINE_SIZE;  // степень двойки
+    bool zeroed = true;     // false: содержимое не определено (буфер сразу перезаписывают)
+    bool hugePages = true;  // madvise(MADV_HUGEPAGE) для буферов от HUGE_PAGE_SIZE
+    bool prefault = true;   // выделить страницы сразу, касаясь их с потоков ThreadPool
+};
+
+// Буферы меньше HUGE_PAGE_SIZE выделяются через aligned_alloc, большие —
+// через mmap с адресом, выровненным по огромной странице (иначе THP не
+// покрывает начало буфера). Первое касание страниц большого буфера делится
+// на равные куски между потоками пула: на NUMA-машине каждая часть массива
+// оказывается в памяти узла, чей поток потом её и обрабатывает.
+void* allocateAligned(size_t bytes, const BufferOptions& options);
+void freeAligned(void* data, size_t bytes);
+
+// Массив фиксированного размера в выровненной памяти — замена std::vector
+// для больших массивов. Копирование запрещено, перемещение дешёвое.
+// Стратегии получают его как ArrayView (неявное преобразование).
+template <typename T>
+class AlignedBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "AlignedBuffer хранит только простые типы");
+
+public:
+    AlignedBuffer() = default;
+    explicit AlignedBuffer(size_t size, const BufferOptions& options = BufferOptions())
+        : ptr(size ? static_cast<T*>(allocateAligned(size * sizeof(T), options)) : nullptr), count(size) {}
+    ~AlignedBuffer() { release(); }
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    AlignedBuffer(AlignedBuffer&& other) noexcept
+        : ptr(std::exchange(other.ptr, nullptr)), count(std::exchange(other.count, 0)) {}
+    AlignedBuffer& operator=(AlignedBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            ptr = std::exchange(other.ptr, nullptr);
+            count = std::exchange(other.count, 0);
+        }
+        return *this;
+    }
+
+    T* data() { return ptr; }
+    const T* data() const { return ptr; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    T& operator[](size_t i) { return ptr[i]; }
+    const T& operator[](size_t i) const { return ptr[i]; }
+    T* begin() { return ptr; }
+    T* end() { return ptr + count; }
+    const T* begin() const { return ptr; }
+    const T* end() const { return ptr + count; }
+
+    ArrayView<T> view() { return ArrayView<T>(ptr, count); }
+    ArrayView<const T> view() const { return ArrayView<const T>(ptr, count); }
+    operator ArrayView<T>() { return view(); }
+    operator ArrayView<const T>() const { return view(); }
+
+private:
+    void release() {
+        if (ptr) {
+            freeAligned(ptr, count * sizeof(T));
+        }
+    }
+
+    T* ptr = nullptr;
+    size_t count = 0;
+};
+
+#endif // ALIGNED_BUFFER_H
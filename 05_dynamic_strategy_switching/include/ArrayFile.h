@@ -0,0 +1,162 @@
+#ifndef ARRAY_FILE_H
+#define ARRAY_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "ArrayView.h"
+
+// Двоичный формат массива на диске: 64-байтный заголовок, затем элементы
+// в порядке байт машины. Данные начинаются со смещения 64, поэтому при
+// отображении в память они выровнены по кэш-линии.
+enum class ElementType : uint32_t {
+    INT32 = 1,
+    INT64 = 2,
+    FLOAT32 = 3,
+    FLOAT64 = 4
+};
+
+size_t elementSize(ElementType type);
+const char* elementTypeName(ElementType type);
+
+// Тип элементов файла для типа C++
+template <typename T> struct ElementTypeOf;
+template <> struct ElementTypeOf<int32_t> { static constexpr ElementType value = ElementType::INT32; };
+template <> struct ElementTypeOf<int64_t> { static constexpr ElementType value = ElementType::INT64; };
+template <> struct ElementTypeOf<float> { static constexpr ElementType value = ElementType::FLOAT32; };
+template <> struct ElementTypeOf<double> { static constexpr ElementType value = ElementType::FLOAT64; };
+
+struct ArrayFileHeader {
+    char magic[8];          // "CPPARRAY"
+    uint32_t version;       // ARRAY_FILE_VERSION
+    uint32_t elementType;   // ElementType
+    uint64_t count;         // число элементов
+    uint64_t checksum;      // arrayChecksum() по байтам данных
+    uint32_t flags;         // ARRAY_FILE_DIRTY, если файл изменён без sync()
+    uint8_t reserved[28];
+};
+
+static_assert(sizeof(ArrayFileHeader) == 64, "Заголовок должен занимать ровно 64 байта");
+
+const uint32_t ARRAY_FILE_VERSION = 1;
+const uint32_t ARRAY_FILE_DIRTY = 1;
+
+const uint64_t ARRAY_CHECKSUM_INIT = 14695981039346656037ull;
+
+// Контрольная сумма: FNV-1a по 64-битным словам (хвост — побайтно).
+// Считается по частям: результат для первой части передаётся как seed
+// следующей, если размер каждой части, кроме последней, кратен 8 байтам.
+uint64_t arrayChecksum(const void* data, size_t bytes, uint64_t seed = ARRAY_CHECKSUM_INIT);
+
+// Записывает массив в файл (заголовок и данные — двумя write)
+void saveArrayFile(const std::string& path, ArrayView<const int> data);
+
+// Последовательное чтение массива из файла блоками — без загрузки целиком
+class ArrayFileReader {
+public:
+    explicit ArrayFileReader(const std::string& path);
+    ~ArrayFileReader();
+    ArrayFileReader(const ArrayFileReader&) = delete;
+    ArrayFileReader& operator=(const ArrayFileReader&) = delete;
+
+    size_t size() const { return total; }
+    ElementType elementType() const { return type; }
+
+    // Контрольная сумма из заголовка; действительна, только если wasClean()
+    uint64_t checksum() const { return storedChecksum; }
+    bool wasClean() const { return clean; }
+
+    // Читает до count элементов в buffer; возвращает 0, когда массив прочитан.
+    // T должен совпадать с типом элементов файла.
+    template <typename T>
+    size_t read(T* buffer, size_t count) {
+        requireType(ElementTypeOf<T>::value);
+        return readElements(buffer, count);
+    }
+
+private:
+    void requireType(ElementType requested) const;
+    size_t readElements(void* buffer, size_t count);
+
+    std::string filePath;
+    int fd = -1;
+    ElementType type = ElementType::INT32;
+    size_t total = 0;
+    size_t consumed = 0;
+    uint64_t storedChecksum = 0;
+    bool clean = true;
+};
+
+// Последовательная запись массива блоками. Контрольная сумма считается на лету,
+// заголовок с флагом ARRAY_FILE_DIRTY переписывается начисто в finish().
+class ArrayFileWriter {
+public:
+    ArrayFileWriter(const std::string& path, size_t count, ElementType type = ElementType::INT32);
+    ~ArrayFileWriter();
+    ArrayFileWriter(const ArrayFileWriter&) = delete;
+    ArrayFileWriter& operator=(const ArrayFileWriter&) = delete;
+
+    // Все блоки, кроме последнего, должны занимать целое число 8-байтных слов
+    template <typename T>
+    void write(ArrayView<const T> chunk) {
+        requireType(ElementTypeOf<T>::value);
+        writeElements(chunk.data(), chunk.size());
+    }
+    void finish();
+
+private:
+    void requireType(ElementType requested) const;
+    void writeElements(const void* data, size_t count);
+
+    std::string filePath;
+    int fd = -1;
+    ElementType type = ElementType::INT32;
+    size_t total = 0;
+    size_t written = 0;
+    uint64_t checksum = ARRAY_CHECKSUM_INIT;
+};
+
+// Массив int32 в файле, отображённый в память через mmap (MAP_SHARED).
+// Стратегии и ArrayMultiplier работают прямо со страницами файла через view():
+// при открытии ничего не читается и не копируется, изменения попадают в файл.
+class MappedArray {
+public:
+    // Открывает существующий файл на чтение и запись. Содержимое не проверяется,
+    // чтобы открытие не требовало прохода по данным — для проверки есть verify().
+    static MappedArray open(const std::string& path);
+
+    MappedArray(MappedArray&& other) noexcept;
+    MappedArray& operator=(MappedArray&& other) noexcept;
+    MappedArray(const MappedArray&) = delete;
+    MappedArray& operator=(const MappedArray&) = delete;
+    ~MappedArray();
+
+    ArrayView<int> view() const;
+    size_t size() const;
+    const std::string& path() const { return filePath; }
+
+    // Был ли файл корректно закрыт (sync) после последнего изменения.
+    // Если нет — контрольная сумма в заголовке устарела.
+    bool wasClean() const { return clean; }
+
+    // Сверяет данные с контрольной суммой из заголовка (полный проход)
+    bool verify() const;
+
+    // Пересчитывает контрольную сумму, снимает флаг ARRAY_FILE_DIRTY и
+    // сбрасывает изменённые страницы на диск. Вызывается перед закрытием:
+    // изменения после sync() снова сделают сумму устаревшей незаметно.
+    void sync();
+
+private:
+    MappedArray(std::string path, int fd, void* base, size_t length, bool clean);
+    ArrayFileHeader* header() const;
+    void release();
+
+    std::string filePath;
+    int fd = -1;
+    void* base = nullptr;
+    size_t length = 0;
+    bool clean = true;
+};
+
+#endif // ARRAY_FILE_H
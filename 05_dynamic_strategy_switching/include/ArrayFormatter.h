@@ -0,0 +1,67 @@
+#ifndef ARRAY_FORMATTER_H
+#define ARRAY_FORMATTER_H
+
+#include <charconv>
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+// Быстрый вывод массивов: числа форматируются std::to_chars в переиспользуемый
+// буфер, который отправляется в поток одним write. Поток не сбрасывается
+// (никаких std::endl) — это делает вызывающий код, когда нужно.
+class ArrayFormatter {
+public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+    explicit ArrayFormatter(std::ostream& out, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+    ~ArrayFormatter();
+
+    ArrayFormatter(const ArrayFormatter&) = delete;
+    ArrayFormatter& operator=(const ArrayFormatter&) = delete;
+
+    ArrayFormatter& append(std::string_view text);
+    ArrayFormatter& append(long long value);
+
+    // Все элементы через separator
+    ArrayFormatter& appendArray(const int* data, size_t size, std::string_view separator);
+
+    // Сокращённый вид: edge первых … edge последних (всего N элементов).
+    // at(i) возвращает i-й элемент — так можно печатать массив, не материализуя его.
+    template <typename Accessor>
+    ArrayFormatter& appendPreview(size_t size, size_t edge, std::string_view separator, Accessor at);
+
+    // Отправляет накопленное в поток (один write)
+    void flush();
+
+private:
+    void reserve(size_t bytes);
+
+    std::ostream& out;
+    std::vector<char> buffer;
+    size_t used = 0;
+};
+
+template <typename Accessor>
+ArrayFormatter& ArrayFormatter::appendPreview(size_t size, size_t edge, std::string_view separator,
+                                              Accessor at) {
+    if (size <= 2 * edge) {
+        for (size_t i = 0; i < size; i++) {
+            if (i > 0) {
+                append(separator);
+            }
+            append(static_cast<long long>(at(i)));
+        }
+        return *this;
+    }
+    for (size_t i = 0; i < edge; i++) {
+        append(static_cast<long long>(at(i))).append(separator);
+    }
+    append("…");
+    for (size_t i = size - edge; i < size; i++) {
+        append(separator).append(static_cast<long long>(at(i)));
+    }
+    return append(" (всего ").append(static_cast<long long>(size)).append(" элементов)");
+}
+
+#endif // ARRAY_FORMATTER_H
@@ -0,0 +1,22 @@
+#ifndef ARRAY_LOADER_H
+#define ARRAY_LOADER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include "AlignedBuffer.h"
+
+// Неинтерактивная загрузка массивов.
+// Текстовый формат: количество элементов, затем сами элементы через любые
+// пробельные символы. Разбор через std::from_chars, память выделяется один раз.
+// Массивы возвращаются в выровненных буферах (AlignedBuffer).
+AlignedBuffer<int> parseArray(std::string_view text);
+
+// Читает файл целиком одним вызовом и разбирает его parseArray
+AlignedBuffer<int> loadArrayFile(const std::string& path);
+
+// Синтетический массив из n элементов в диапазоне [-1000, 1000] для нагрузочных тестов.
+// Один и тот же seed даёт один и тот же массив.
+AlignedBuffer<int> generateArray(size_t n, unsigned seed = 1);
+
+#endif // ARRAY_LOADER_H
@@ -0,0 +1,46 @@
+#ifndef ARRAY_VIEW_H
+#define ARRAY_VIEW_H
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+// Невладеющее представление непрерывного массива (аналог std::span для C++17).
+// Позволяет стратегиям работать с любой памятью: std::vector, отображённым
+// в память файлом, частью большего массива — без копирования.
+template <typename T>
+class ArrayView {
+public:
+    using value_type = std::remove_cv_t<T>;
+
+    ArrayView() = default;
+    ArrayView(T* data, size_t size) : ptr(data), count(size) {}
+
+    // Неявное преобразование из std::vector, чтобы старый код вызывался без изменений
+    template <typename Alloc>
+    ArrayView(std::vector<value_type, Alloc>& vec) : ptr(vec.data()), count(vec.size()) {}
+
+    template <typename Alloc, typename U = T, typename = std::enable_if_t<std::is_const<U>::value>>
+    ArrayView(const std::vector<value_type, Alloc>& vec) : ptr(vec.data()), count(vec.size()) {}
+
+    // ArrayView<int> → ArrayView<const int>
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U (*)[], T (*)[]>::value>>
+    ArrayView(const ArrayView<U>& other) : ptr(other.data()), count(other.size()) {}
+
+    T* data() const { return ptr; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    T& operator[](size_t i) const { return ptr[i]; }
+    T* begin() const { return ptr; }
+    T* end() const { return ptr + count; }
+
+    // Часть массива [offset, offset + length)
+    ArrayView subview(size_t offset, size_t length) const { return ArrayView(ptr + offset, length); }
+
+private:
+    T* ptr = nullptr;
+    size_t count = 0;
+};
+
+#endif // ARRAY_VIEW_H
@@ -0,0 +1,55 @@
+#ifndef ASYNC_MULTIPLY_H
+#define ASYNC_MULTIPLY_H
+
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include "MultiplicationStrategy.h"
+
+// Прогресс фоновой операции и запрос её отмены. Фоновый поток пишет
+// счётчики, любой другой поток читает их и может попросить отмену.
+// Отмена кооперативная: поток проверяет флаг между группами блоков.
+class OperationProgress {
+public:
+    void cancel() { cancelRequested.store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return cancelRequested.load(std::memory_order_relaxed); }
+
+    bool isStarted() const { return started.load(std::memory_order_acquire); }
+    size_t completedChunks() const { return completed.load(std::memory_order_relaxed); }
+    size_t totalChunks() const { return total.load(std::memory_order_relaxed); }
+
+    // Доля выполненной работы от 0 до 1
+    double fraction() const {
+        size_t all = totalChunks();
+        return all == 0 ? 0.0 : static_cast<double>(completedChunks()) / static_cast<double>(all);
+    }
+
+    // Вызывается фоновым потоком
+    void start(size_t chunks) {
+        total.store(chunks, std::memory_order_relaxed);
+        started.store(true, std::memory_order_release);
+    }
+    void advance(size_t chunks) { completed.fetch_add(chunks, std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> cancelRequested{false};
+    std::atomic<bool> started{false};
+    std::atomic<size_t> completed{0};
+    std::atomic<size_t> total{0};
+};
+
+// Итог фоновой операции. При отмене массив и история возвращены
+// к состоянию до операции, а суммы не заполняются.
+struct AsyncMultiplyResult {
+    bool cancelled = false;
+    MultiplyResult sums;
+};
+
+// Результат multiplyArrayAsync: future итога и прогресс для опроса и отмены
+struct AsyncMultiply {
+    std::shared_future<AsyncMultiplyResult> result;
+    std::shared_ptr<OperationProgress> progress;
+};
+
+#endif // ASYNC_MULTIPLY_H
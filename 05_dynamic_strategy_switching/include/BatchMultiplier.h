@@ -0,0 +1,39 @@
+#ifndef BATCH_MULTIPLIER_H
+#define BATCH_MULTIPLIER_H
+
+#include <cstddef>
+#include "ArrayView.h"
+#include "MultiplicationStrategy.h"
+
+// Одно задание пакета. Стратегия может быть общей для нескольких заданий:
+// её multiply() вызывается из разных потоков для разных массивов
+// (все стратегии из StrategyFactory это допускают).
+struct BatchJob {
+    ArrayView<int> array;
+    int k = 1;
+    MultiplicationStrategy* strategy = nullptr;
+};
+
+struct BatchStats {
+    size_t jobs = 0;
+    size_t elements = 0;
+    size_t tasks = 0;      // задач после разбиения и объединения
+    size_t splitJobs = 0;  // заданий, разбитых на части
+    size_t steals = 0;     // задач, выполненных не своим потоком
+    double seconds = 0;
+};
+
+// Задания длиннее BATCH_SPLIT_ELEMENTS режутся на части такого размера,
+// а подряд идущие мелкие объединяются в задачи не меньше BATCH_GRAIN_ELEMENTS,
+// чтобы накладные расходы на задачу не превышали саму работу
+const size_t BATCH_SPLIT_ELEMENTS = 1 << 15;
+const size_t BATCH_GRAIN_ELEMENTS = 1 << 13;
+
+// Умножает все массивы пакета на пуле потоков ThreadPool и ждёт завершения.
+// Задачи заранее распределяются между потоками поровну по числу элементов;
+// поток, закончивший свою часть, забирает задачи с конца чужих очередей
+// (work stealing), поэтому перекос размеров массивов не оставляет ядра без работы.
+// Массивы разных заданий не должны перекрываться.
+BatchStats multiplyBatch(ArrayView<const BatchJob> jobs);
+
+#endif // BATCH_MULTIPLIER_H
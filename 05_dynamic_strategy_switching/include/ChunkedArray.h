@@ -0,0 +1,139 @@
+#ifndef CHUNKED_ARRAY_H
+#define CHUNKED_ARRAY_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ArrayView.h"
+
+// Массив REPL из блоков по CHUNK_ELEMENTS элементов с копированием при записи.
+//
+// Блоки — общие объекты со счётчиком ссылок. version() копирует только список
+// ссылок на блоки (O(числа блоков)), поэтому снимок для истории ничего не
+// копирует. Блок, на который ссылается чья-то версия, перед записью копируется
+// (writable), а не изменённые операцией блоки так и остаются общими.
+// Обнулённые блоки ссылаются на один общий нулевой блок и памяти не занимают.
+//
+// Исходные блоки указывают прямо в память base (std::vector или отображённый
+// файл) без копирования. Пока на блок никто больше не ссылается, запись идёт
+// на месте, как раньше; копии блоков выделяются в куче.
+class ChunkedArray {
+public:
+    static constexpr size_t CHUNK_ELEMENTS = 1 << 16;
+
+    struct Chunk;
+
+    // Неизменяемое состояние массива: ссылки на его блоки
+    class Version {
+    public:
+        size_t size() const { return elements; }
+
+    private:
+        friend class ChunkedArray;
+        std::vector<std::shared_ptr<Chunk>> chunks;
+        size_t elements = 0;
+    };
+
+    // Блоки ссылаются на base; base должен жить дольше массива
+    explicit ChunkedArray(ArrayView<int> base);
+
+    size_t size() const { return elements; }
+    size_t chunkCount() const { return chunks.size(); }
+
+    ArrayView<const int> chunk(size_t index) const;
+    // Блок для записи: общий блок сначала копируется
+    ArrayView<int> writable(size_t index);
+
+    bool isZero(size_t index) const;
+    // Делает блок нулевым без записи в память
+    void setZero(size_t index);
+
+    int at(size_t index) const;
+
+    Version version() const;
+    void restore(const Version& version);
+
+    // Копирует содержимое в target (size() элементов). Блоки, которые уже
+    // лежат на своём месте в target, не копируются. Если target — память base,
+    // версии с исходными блоками base после этого недействительны: вызывать
+    // только при завершении работы.
+    void copyTo(ArrayView<int> target) const;
+    // Записывает массив в двоичный файл (формат ArrayFile)
+    void save(const std::string& path) const;
+
+    // Байты копий блоков в куче, на которые ссылается текущее состояние
+    size_t ownedBytes() const;
+    // Байты всех копий блоков в куче — текущих и удерживаемых версиями
+    static size_t heapBytes();
+
+    // fn(ArrayView<const int>) для блоков [first, last) по порядку;
+    // блоки, лежащие в памяти подряд, передаются одним куском
+    template <typename Fn>
+    void forEachRun(size_t first, size_t last, Fn fn) const;
+    template <typename Fn>
+    void forEachRun(Fn fn) const { forEachRun(0, chunks.size(), fn); }
+
+    // fn(ArrayView<int>) для ненулевых блоков [first, last), подготовленных
+    // к записи; подряд лежащие — одним куском. Нулевые блоки пропускаются:
+    // умножение и точное деление оставляют их нулевыми.
+    template <typename Fn>
+    void forEachWritableRun(size_t first, size_t last, Fn fn);
+    template <typename Fn>
+    void forEachWritableRun(Fn fn) { forEachWritableRun(0, chunks.size(), fn); }
+
+private:
+    size_t chunkLength(size_t index) const;
+    const int* chunkData(size_t index) const;
+    int* writableData(size_t index);
+
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    size_t elements = 0;
+};
+
+template <typename Fn>
+void ChunkedArray::forEachRun(size_t first, size_t last, Fn fn) const {
+    const int* runStart = nullptr;
+    size_t runLength = 0;
+    for (size_t i = first; i < last; i++) {
+        const int* data = chunkData(i);
+        if (runLength > 0 && runStart + runLength == data) {
+            runLength += chunkLength(i);
+            continue;
+        }
+        if (runLength > 0) {
+            fn(ArrayView<const int>(runStart, runLength));
+        }
+        runStart = data;
+        runLength = chunkLength(i);
+    }
+    if (runLength > 0) {
+        fn(ArrayView<const int>(runStart, runLength));
+    }
+}
+
+template <typename Fn>
+void ChunkedArray::forEachWritableRun(size_t first, size_t last, Fn fn) {
+    int* runStart = nullptr;
+    size_t runLength = 0;
+    for (size_t i = first; i < last; i++) {
+        if (isZero(i)) {
+            continue;
+        }
+        int* data = writableData(i);
+        if (runLength > 0 && runStart + runLength == data) {
+            runLength += chunkLength(i);
+            continue;
+        }
+        if (runLength > 0) {
+            fn(ArrayView<int>(runStart, runLength));
+        }
+        runStart = data;
+        runLength = chunkLength(i);
+    }
+    if (runLength > 0) {
+        fn(ArrayView<int>(runStart, runLength));
+    }
+}
+
+#endif // CHUNKED_ARRAY_H
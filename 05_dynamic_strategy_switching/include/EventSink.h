@@ -0,0 +1,101 @@
+#ifndef EVENT_SINK_H
+#define EVENT_SINK_H
+
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include "SpscQueue.h"
+
+// События ArrayMultiplier. Стратегии и контекст ничего не печатают сами:
+// они отправляют событие в EventSink, а как и когда его показать, решает
+// приёмник. Так консоль не попадает в замеры и не тормозит горячий путь.
+enum class EventType {
+    STRATEGY_CHANGED,  // strategy
+    MULTIPLIED,        // strategy, multiplier, elements, oldSum, newSum, deferred
+    UNDONE,            // strategy, multiplier
+    NOTHING_TO_UNDO,
+    REDONE,            // strategy, multiplier
+    NOTHING_TO_REDO,
+    CANCELLED          // strategy, multiplier, elements (успело обработаться до отмены)
+};
+
+// Событие фиксированного размера: отправка не выделяет память,
+// и событие можно копировать в очередь без блокировок
+struct StrategyEvent {
+    static constexpr size_t NAME_CAPACITY = 96;
+
+    EventType type = EventType::STRATEGY_CHANGED;
+    char strategy[NAME_CAPACITY] = {};  // имя обрезается по границе символа UTF-8
+    int multiplier = 0;
+    size_t elements = 0;
+    long long oldSum = 0;
+    long long newSum = 0;
+    bool deferred = false;
+
+    StrategyEvent() = default;
+    StrategyEvent(EventType type, const std::string& strategyName);
+};
+
+// Приёмник событий. emit() вызывается из одного потока — потока ArrayMultiplier.
+class EventSink {
+public:
+    virtual ~EventSink() = default;
+    virtual void emit(const StrategyEvent& event) = 0;
+    // Дождаться, пока отправленные события будут показаны
+    virtual void flush() {}
+};
+
+// Отбрасывает все события: для бенчмарков и пакетной работы
+class NullEventSink final : public EventSink {
+public:
+    void emit(const StrategyEvent&) override {}
+};
+
+// Печатает события сразу, в потоке отправителя
+class ConsoleEventSink final : public EventSink {
+public:
+    explicit ConsoleEventSink(std::ostream& out = std::cout) : out(out) {}
+
+    void emit(const StrategyEvent& event) override;
+    void flush() override;
+
+private:
+    std::ostream& out;
+};
+
+// Передаёт события в другой приёмник через очередь SpscQueue; вывод идёт
+// в фоновом потоке. Если очередь заполнена, событие отбрасывается и
+// учитывается в dropped() — отправитель никогда не ждёт.
+class AsyncEventSink final : public EventSink {
+public:
+    static constexpr size_t QUEUE_CAPACITY = 1024;
+
+    explicit AsyncEventSink(std::unique_ptr<EventSink> target);
+    ~AsyncEventSink() override;
+
+    AsyncEventSink(const AsyncEventSink&) = delete;
+    AsyncEventSink& operator=(const AsyncEventSink&) = delete;
+
+    void emit(const StrategyEvent& event) override;
+    void flush() override;
+
+    size_t dropped() const {
+        return droppedEvents.load(std::memory_order_relaxed);
+    }
+
+private:
+    void run();
+
+    std::unique_ptr<EventSink> target;
+    SpscQueue<StrategyEvent, QUEUE_CAPACITY> queue;
+    size_t sent = 0;                       // только поток отправителя
+    std::atomic<size_t> delivered{0};
+    std::atomic<size_t> droppedEvents{0};
+    std::atomic<bool> stopping{false};
+    std::thread consumer;
+};
+
+#endif // EVENT_SINK_H
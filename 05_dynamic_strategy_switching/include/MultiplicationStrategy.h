@@ -4,41 +4,148 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+#include "ArrayView.h"
 
-// Базовый интерфейс стратегии
+// Суммы массива до и после умножения, посчитанные за тот же проход
+struct MultiplyResult {
+    long long oldSum = 0;
+    long long newSum = 0;
+};
+
+// Произведение, которое для целых типов переполняется по модулю 2^N, как
+// SIMD-ядра: знаковое переполнение — неопределённое поведение, поэтому
+// умножение идёт в беззнаковом типе. Для float и double — обычное.
+template <typename T>
+inline T wrappingMultiply(T value, T k) {
+    if constexpr (std::is_integral<T>::value) {
+        using U = std::make_unsigned_t<T>;
+        return static_cast<T>(static_cast<U>(value) * static_cast<U>(k));
+    } else {
+        return value * k;
+    }
+}
+
+// Базовый интерфейс стратегии.
+// Стратегии работают с ArrayView<int>: std::vector<int> передаётся как раньше
+// (неявное преобразование), а отображённые файлы и части массивов — без копирования.
 class MultiplicationStrategy {
 public:
     virtual ~MultiplicationStrategy() = default;
-    virtual void multiply(std::vector<int>& arr, int k) = 0;
+    virtual void multiply(ArrayView<int> arr, int k) = 0;
     virtual std::string getName() const = 0;
+
+    // Совмещённый проход: умножение, обе суммы и (если snapshot != nullptr)
+    // копия исходных значений в snapshot[0 .. arr.size()).
+    // Реализация по умолчанию — скалярный цикл; стратегии переопределяют её
+    // своим ядром, иначе выбор стратегии не влиял бы на умножение в REPL.
+    virtual MultiplyResult multiplyWithSum(ArrayView<int> arr, int k, int* snapshot);
 };
 
+// Стратегии объявлены final: при вызове через объект конкретного типа
+// (StaticArrayMultiplier) компилятор вызывает метод напрямую, без vtable.
+// kernel() — тело стратегии для любого типа элементов (int, int64_t, float,
+// double); у простых стратегий оно в заголовке, чтобы встраиваться в вызов.
+// Виртуальные multiply() и multiplyWithSum() — то же ядро для int.
+
 // Конкретная стратегия: умножение через обычный цикл
-class LoopMultiplication : public MultiplicationStrategy {
+class LoopMultiplication final : public MultiplicationStrategy {
 public:
-    void multiply(std::vector<int>& arr, int k) override;
+    template <typename T>
+    static void kernel(ArrayView<T> arr, T k) {
+        for (size_t i = 0; i < arr.size(); i++) {
+            arr[i] = wrappingMultiply(arr[i], k);
+        }
+    }
+
+    void multiply(ArrayView<int> arr, int k) override;
     std::string getName() const override;
+    MultiplyResult multiplyWithSum(ArrayView<int> arr, int k, int* snapshot) override;
 };
 
 // Конкретная стратегия: умножение через указатели
-class PointerMultiplication : public MultiplicationStrategy {
+class PointerMultiplication final : public MultiplicationStrategy {
 public:
-    void multiply(std::vector<int>& arr, int k) override;
+    template <typename T>
+    static void kernel(ArrayView<T> arr, T k) {
+        T* ptr = arr.data();
+        T* end = ptr + arr.size();
+
+        while (ptr < end) {
+            *ptr = wrappingMultiply(*ptr, k);
+            ptr++;
+        }
+    }
+
+    void multiply(ArrayView<int> arr, int k) override;
     std::string getName() const override;
+    MultiplyResult multiplyWithSum(ArrayView<int> arr, int k, int* snapshot) override;
 };
 
 // Конкретная стратегия: умножение через STL transform
-class TransformMultiplication : public MultiplicationStrategy {
+class TransformMultiplication final : public MultiplicationStrategy {
 public:
-    void multiply(std::vector<int>& arr, int k) override;
+    template <typename T>
+    static void kernel(ArrayView<T> arr, T k) {
+        std::transform(arr.begin(), arr.end(), arr.begin(),
+                      [k](T x) { return wrappingMultiply(x, k); });
+    }
+
+    void multiply(ArrayView<int> arr, int k) override;
     std::string getName() const override;
+    MultiplyResult multiplyWithSum(ArrayView<int> arr, int k, int* snapshot) override;
 };
 
 // Конкретная стратегия: умножение через range-based for
-class RangeMultiplication : public MultiplicationStrategy {
+class RangeMultiplication final : public MultiplicationStrategy {
 public:
-    void multiply(std::vector<int>& arr, int k) override;
+    template <typename T>
+    static void kernel(ArrayView<T> arr, T k) {
+        for (auto& element : arr) {
+            element = wrappingMultiply(element, k);
+        }
+    }
+
+    void multiply(ArrayView<int> arr, int k) override;
     std::string getName() const override;
+    MultiplyResult multiplyWithSum(ArrayView<int> arr, int k, int* snapshot) override;
+};
+
+// Конкретная стратегия: умножение через SIMD-инструкции (SSE4.1/AVX2/AVX-512)
+// Набор инструкций выбирается один раз во время выполнения по CPUID
+class SimdMultiplication final : public MultiplicationStrategy {
+public:
+    // Определено для int, int64_t, float и double (SimdMultiplication.cpp)
+    template <typename T>
+    static void kernel(ArrayView<T> arr, T k);
+
+    void multiply(ArrayView<int> arr, int k) override;
+    std::string getName() const override;
+    MultiplyResult multiplyWithSum(ArrayView<int> arr, int k, int* snapshot) override;
+};
+
+// Конкретная стратегия: многопоточное умножение на постоянном пуле потоков
+// Куски массива выровнены по кэш-линии, поэтому потоки не пишут в общую линию.
+// Массивы меньше порога обрабатываются последовательно без пробуждения потоков.
+class ParallelMultiplication final : public MultiplicationStrategy {
+public:
+    static constexpr size_t DEFAULT_THRESHOLD = 1 << 16;
+
+    explicit ParallelMultiplication(size_t threshold = DEFAULT_THRESHOLD);
+
+    // Определено для int, int64_t, float и double (ParallelMultiplication.cpp)
+    template <typename T>
+    void kernel(ArrayView<T> arr, T k) const;
+
+    void multiply(ArrayView<int> arr, int k) override;
+    std::string getName() const override;
+    MultiplyResult multiplyWithSum(ArrayView<int> arr, int k, int* snapshot) override;
+    size_t getThreshold() const;
+
+private:
+    size_t threshold;
 };
 
 #endif // MULTIPLICATION_STRATEGY_H
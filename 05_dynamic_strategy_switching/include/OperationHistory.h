@@ -1,17 +1,26 @@
 #ifndef OPERATION_HISTORY_H
 #define OPERATION_HISTORY_H
 
-#include <vector>
 #include <string>
-#include <deque>
+#include <optional>
+#include "ChunkedArray.h"
 
 // Структура для хранения истории операций
 struct OperationHistory {
     std::string strategyName;
+    int strategyType;  // StrategyFactory::StrategyType — для redo и журнала
     int multiplier;
-    std::vector<int> previousState;
-    
-    OperationHistory(const std::string& name, int k, const std::vector<int>& state);
+    // Состояние массива до операции — только если операция теряет информацию
+    // (k = 0 или переполнение). Это версия ChunkedArray: она делит с массивом
+    // все блоки, которые операция не изменила, и сама ничего не копирует.
+    std::optional<ChunkedArray::Version> previousState;
+
+    // Обратимая операция: отменяется точным делением на k, снимок не нужен
+    OperationHistory(const std::string& name, int type, int k);
+    // Необратимая операция: отменяется возвратом к state
+    OperationHistory(const std::string& name, int type, int k, ChunkedArray::Version state);
+
+    bool hasSnapshot() const { return previousState.has_value(); }
 };
 
 #endif // OPERATION_HISTORY_H
@@ -0,0 +1,97 @@
+#ifndef OPERATION_JOURNAL_H
+#define OPERATION_JOURNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AlignedBuffer.h"
+#include "ChunkedArray.h"
+
+// Журнал операций на диске (write-ahead log) для REPL.
+//
+// Файлы журнала <path>:
+//   <path>                   — заголовок с номером поколения и записи по 16 байт;
+//   <path>.checkpoint-<N>    — контрольная точка поколения N: весь массив в формате ArrayFile.
+// Состояние = контрольная точка + записи журнала после неё. Запись — только
+// номер стратегии и k, поэтому объём ввода-вывода пропорционален числу
+// операций, а не размеру массива; массив целиком пишется лишь в контрольных
+// точках раз в checkpointEvery записей.
+//
+// Записи отправляются в файл сразу (write), а fdatasync выполняется пачками по
+// SYNC_BATCH записей, перед контрольной точкой и при закрытии. При сбое питания
+// теряются не больше SYNC_BATCH - 1 последних операций, при падении процесса — ни одной.
+// Оборванная или повреждённая последняя запись при восстановлении отбрасывается.
+
+struct JournalRecord {
+    enum Type : uint8_t {
+        MULTIPLY = 1,
+        UNDO = 2
+    };
+
+    uint8_t type;
+    uint8_t strategy;    // StrategyFactory::StrategyType для MULTIPLY
+    uint16_t reserved;
+    int32_t k;
+    uint32_t sequence;   // номер записи внутри поколения
+    uint32_t checksum;   // FNV-1a по первым 12 байтам
+};
+
+static_assert(sizeof(JournalRecord) == 16, "Запись журнала должна занимать 16 байт");
+
+class OperationJournal {
+public:
+    static const size_t SYNC_BATCH = 32;
+    static const size_t DEFAULT_CHECKPOINT_EVERY = 1000;
+
+    // Состояние из журнала: массив последней контрольной точки
+    // и записи после неё в порядке выполнения
+    struct Recovery {
+        AlignedBuffer<int> array;
+        std::vector<JournalRecord> records;
+        size_t discardedBytes = 0;  // отброшенный оборванный хвост
+    };
+
+    static bool exists(const std::string& path);
+
+    // Читает журнал и контрольную точку; оборванный хвост отрезается от файла
+    static Recovery recover(const std::string& path);
+
+    // Создаёт новый журнал с контрольной точкой initial (поколение 1)
+    static void initialize(const std::string& path, const ChunkedArray& initial);
+
+    // Открывает существующий журнал для дозаписи
+    OperationJournal(const std::string& path, size_t checkpointEvery = DEFAULT_CHECKPOINT_EVERY);
+    ~OperationJournal();
+
+    OperationJournal(const OperationJournal&) = delete;
+    OperationJournal& operator=(const OperationJournal&) = delete;
+
+    void logMultiply(int strategyType, int k);
+    void logUndo();
+
+    // Пора ли писать контрольную точку
+    bool checkpointDue() const { return recordCount >= checkpointEvery; }
+
+    // Записывает массив как контрольную точку следующего поколения и
+    // начинает журнал заново. Массив должен быть материализован.
+    void checkpoint(const ChunkedArray& arr);
+
+    // fdatasync для уже записанных записей
+    void sync();
+
+    uint64_t generation() const { return currentGeneration; }
+    size_t recordsSinceCheckpoint() const { return recordCount; }
+
+private:
+    void append(JournalRecord record);
+
+    std::string filePath;
+    int fd = -1;
+    uint64_t currentGeneration = 0;
+    size_t recordCount = 0;
+    size_t unsynced = 0;
+    size_t checkpointEvery;
+};
+
+#endif // OPERATION_JOURNAL_H
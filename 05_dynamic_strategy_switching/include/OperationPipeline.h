@@ -0,0 +1,150 @@
+#ifndef OPERATION_PIPELINE_H
+#define OPERATION_PIPELINE_H
+
+#include <cstddef>
+#include <type_traits>
+#include "ArrayView.h"
+
+// Конвейер операций над массивом, собираемый через operator|:
+//
+//   auto plan = pipeline::multiply(3) | pipeline::add(10) | pipeline::reverse() | pipeline::sum();
+//   long long total = plan.run(arr);
+//
+// Каждая стадия — отдельный тип (expression templates), поэтому весь конвейер
+// компилируется в один цикл: поэлементные стадии сливаются в одну функцию,
+// встроенную в тело цикла, а сумма считается в том же проходе.
+// Поэлементные операции не зависят от порядка элементов, поэтому любое число
+// разворотов сводится к одному (или ни одному) и выполняется тем же проходом
+// двумя указателями навстречу друг другу.
+namespace pipeline {
+
+// Сумма для целых — long long, для float и double — double
+template <typename T>
+using SumType = std::conditional_t<std::is_floating_point<T>::value, double, long long>;
+
+struct Identity {
+    template <typename T>
+    T operator()(T x) const { return x; }
+};
+
+// Целые стадии переполняются по модулю 2^N, как SIMD-ядра и undo:
+// знаковое переполнение — неопределённое поведение, поэтому для целых T
+// арифметика идёт в беззнаковом типе
+template <typename T>
+using WrapType = typename std::conditional_t<std::is_integral<T>::value, std::make_unsigned<T>,
+                                             std::enable_if<true, T>>::type;
+
+template <typename V>
+struct Multiply {
+    V k;
+    template <typename T>
+    T operator()(T x) const {
+        return static_cast<T>(static_cast<WrapType<T>>(x) * static_cast<WrapType<T>>(static_cast<T>(k)));
+    }
+};
+
+template <typename V>
+struct Add {
+    V offset;
+    template <typename T>
+    T operator()(T x) const {
+        return static_cast<T>(static_cast<WrapType<T>>(x) + static_cast<WrapType<T>>(static_cast<T>(offset)));
+    }
+};
+
+// Сначала First, затем Second
+template <typename First, typename Second>
+struct Then {
+    First first;
+    Second second;
+    template <typename T>
+    T operator()(T x) const { return second(first(x)); }
+};
+
+// Map — поэлементная часть, Reversed — чётность числа разворотов,
+// Summed — конвейер заканчивается суммой
+template <typename Map, bool Reversed, bool Summed>
+class Pipeline {
+public:
+    explicit Pipeline(Map map = Map()) : map(map) {}
+
+    // Применяет конвейер к массиву на месте за один проход.
+    // Возвращает сумму результата, если последняя стадия — sum().
+    template <typename T>
+    auto run(ArrayView<T> arr) const {
+        SumType<T> total = 0;
+        T* data = arr.data();
+        size_t n = arr.size();
+        if constexpr (Reversed) {
+            for (size_t i = 0; i < n / 2; i++) {
+                T front = map(data[i]);
+                T back = map(data[n - 1 - i]);
+                data[i] = back;
+                data[n - 1 - i] = front;
+                if constexpr (Summed) {
+                    total += static_cast<SumType<T>>(front) + static_cast<SumType<T>>(back);
+                }
+            }
+            if (n % 2 != 0) {
+                data[n / 2] = map(data[n / 2]);
+                if constexpr (Summed) {
+                    total += data[n / 2];
+                }
+            }
+        } else {
+            for (size_t i = 0; i < n; i++) {
+                T value = map(data[i]);
+                data[i] = value;
+                if constexpr (Summed) {
+                    total += value;
+                }
+            }
+        }
+        if constexpr (Summed) {
+            return total;
+        }
+    }
+
+    // std::vector и другие контейнеры
+    template <typename Container>
+    auto run(Container& container) const {
+        return run(ArrayView<typename Container::value_type>(container.data(), container.size()));
+    }
+
+    const Map& elementwise() const { return map; }
+
+private:
+    Map map;
+};
+
+template <typename MapA, bool ReversedA, bool SummedA, typename MapB, bool ReversedB, bool SummedB>
+Pipeline<Then<MapA, MapB>, ReversedA != ReversedB, SummedB>
+operator|(const Pipeline<MapA, ReversedA, SummedA>& a, const Pipeline<MapB, ReversedB, SummedB>& b) {
+    static_assert(!SummedA, "sum() должна быть последней стадией конвейера");
+    return Pipeline<Then<MapA, MapB>, ReversedA != ReversedB, SummedB>(
+        Then<MapA, MapB>{a.elementwise(), b.elementwise()});
+}
+
+// Стадии
+
+template <typename V>
+Pipeline<Multiply<V>, false, false> multiply(V k) {
+    return Pipeline<Multiply<V>, false, false>(Multiply<V>{k});
+}
+
+template <typename V>
+Pipeline<Add<V>, false, false> add(V offset) {
+    return Pipeline<Add<V>, false, false>(Add<V>{offset});
+}
+
+inline Pipeline<Identity, true, false> reverse() {
+    return Pipeline<Identity, true, false>();
+}
+
+inline Pipeline<Identity, false, true> sum() {
+    return Pipeline<Identity, false, true>();
+}
+
+} // namespace pipeline
+
+#endif // OPERATION_PIPELINE_H
@@ -0,0 +1,76 @@
+#ifndef OPERATION_STATS_H
+#define OPERATION_STATS_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+
+// Замеряемые операции ArrayMultiplier
+enum class Operation {
+    MULTIPLY,       // multiplyArray целиком (включая saveHistory)
+    SAVE_HISTORY,   // резервирование записи истории и снимка
+    UNDO,
+    REDO
+};
+
+const char* operationName(Operation operation);
+
+// Счётчики одной пары «операция, стратегия»
+struct TimingStats {
+    // Корзина i — длительности в [2^i, 2^(i+1)) нс; последняя — всё длиннее
+    static constexpr size_t HISTOGRAM_BUCKETS = 40;
+
+    uint64_t calls = 0;
+    uint64_t elements = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+    std::array<uint64_t, HISTOGRAM_BUCKETS> histogram{};
+
+    void record(uint64_t ns, size_t elementCount);
+};
+
+// Статистика времени операций по стратегиям. Записи std::map не перемещаются,
+// поэтому вызывающий код может один раз получить slot() и дальше писать
+// в TimingStats напрямую, без поиска по строкам на каждом вызове.
+class OperationStats {
+public:
+    TimingStats& slot(Operation operation, const std::string& strategy);
+
+    bool empty() const { return entries.empty(); }
+    void print(std::ostream& out) const;
+    void writeJson(std::ostream& out) const;
+
+private:
+    std::map<std::pair<Operation, std::string>, TimingStats> entries;
+};
+
+// Замер области видимости монотонными часами: время записывается в деструкторе.
+// stats == nullptr — замер выключен.
+class ScopedTimer {
+public:
+    ScopedTimer(TimingStats* stats, size_t elements)
+        : stats(stats), elements(elements), start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        if (stats) {
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            stats->record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()), elements);
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    TimingStats* stats;
+    size_t elements;
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif // OPERATION_STATS_H
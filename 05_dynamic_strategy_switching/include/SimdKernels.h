@@ -0,0 +1,25 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "MultiplicationStrategy.h"
+
+// Умножение массива на k лучшим набором инструкций, доступным на этом CPU.
+// Выбор ядра (AVX-512 → AVX2 → SSE4.1 → скалярное) выполняется при первом вызове.
+void simdMultiply(int* data, size_t size, int k);
+
+// Совмещённое ядро: умножение, суммы до/после и копия в snapshot (если не nullptr)
+// за один проход по данным. Умножение — с переполнением по модулю 2^32, как у SIMD.
+MultiplyResult simdMultiplyWithSum(int* data, size_t size, int k, int* snapshot);
+
+// То же для других типов элементов. int64_t векторизуется только с AVX-512DQ,
+// float и double — с AVX2 или AVX-512; иначе работает скалярный цикл.
+void simdMultiply(int64_t* data, size_t size, int64_t k);
+void simdMultiply(float* data, size_t size, float k);
+void simdMultiply(double* data, size_t size, double k);
+
+// Название набора инструкций, выбранного диспетчером
+const char* simdInstructionSet();
+
+#endif // SIMD_KERNELS_H
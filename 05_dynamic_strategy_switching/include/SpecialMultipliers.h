@@ -0,0 +1,200 @@
+#ifndef SPECIAL_MULTIPLIERS_H
+#define SPECIAL_MULTIPLIERS_H
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include "ArrayView.h"
+#include "MultiplicationStrategy.h"
+
+// Частые множители, для которых умножение не нужно или дешевле:
+//   k = 1  — массив не меняется;
+//   k = 0  — заполнение нулями (memset), только для целых: для float 0 * NaN ≠ 0;
+//   k = -1 — смена знака;
+//   k = 2^n — сдвиг влево, только для целых.
+// Переполнение — по модулю 2^N, как у SIMD-ядер: сдвиг и смена знака идут
+// в беззнаковом типе. Каждый случай — отдельный простой цикл, который
+// компилятор векторизует.
+//
+// Проверка стоит перед стратегиями (ArrayMultiplier, StaticArrayMultiplier,
+// multiplyBatch, потоковый режим), а не внутри них: сами стратегии всегда
+// умножают, поэтому калибровка и бенчмарк измеряют именно их.
+
+enum class MultiplierKind {
+    GENERAL,
+    ONE,
+    ZERO,
+    MINUS_ONE,
+    POWER_OF_TWO
+};
+
+struct MultiplierClass {
+    MultiplierKind kind = MultiplierKind::GENERAL;
+    unsigned shift = 0;  // для POWER_OF_TWO: k = 2^shift
+};
+
+template <typename T>
+constexpr MultiplierClass classifyMultiplier(T k) {
+    if (k == T(1)) {
+        return {MultiplierKind::ONE, 0};
+    }
+    if (k == T(-1)) {
+        return {MultiplierKind::MINUS_ONE, 0};
+    }
+    if constexpr (std::is_integral<T>::value) {
+        if (k == 0) {
+            return {MultiplierKind::ZERO, 0};
+        }
+        if (k > 0 && (k & (k - 1)) == 0) {
+            unsigned shift = 0;
+            while ((k >> shift) != 1) {
+                shift++;
+            }
+            return {MultiplierKind::POWER_OF_TWO, shift};
+        }
+    }
+    return {};
+}
+
+namespace special {
+
+template <typename T>
+void fillZero(ArrayView<T> arr) {
+    static_assert(std::is_integral<T>::value, "Заполнение нулями — только для целых");
+    std::memset(arr.data(), 0, arr.size() * sizeof(T));
+}
+
+template <typename T>
+T negate(T x) {
+    if constexpr (std::is_integral<T>::value) {
+        using U = std::make_unsigned_t<T>;
+        return static_cast<T>(U(0) - static_cast<U>(x));
+    } else {
+        return -x;
+    }
+}
+
+template <typename T>
+T shiftLeft(T x, unsigned shift) {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<T>(static_cast<U>(x) << shift);
+}
+
+template <typename T>
+void negate(ArrayView<T> arr) {
+    T* data = arr.data();
+    for (size_t i = 0; i < arr.size(); i++) {
+        data[i] = negate(data[i]);
+    }
+}
+
+template <typename T>
+void shiftLeft(ArrayView<T> arr, unsigned shift) {
+    T* data = arr.data();
+    for (size_t i = 0; i < arr.size(); i++) {
+        data[i] = shiftLeft(data[i], shift);
+    }
+}
+
+} // namespace special
+
+// Умножение на множитель, известный при компиляции: частный случай
+// выбирается без проверок во время выполнения, а для остальных K
+// компилятор сам заменяет умножение на константу сдвигами и сложениями.
+template <auto K, typename T>
+void multiplyByConstant(ArrayView<T> arr) {
+    constexpr MultiplierClass multiplier = classifyMultiplier(static_cast<T>(K));
+    if constexpr (multiplier.kind == MultiplierKind::ONE) {
+        return;
+    } else if constexpr (multiplier.kind == MultiplierKind::ZERO) {
+        special::fillZero(arr);
+    } else if constexpr (multiplier.kind == MultiplierKind::MINUS_ONE) {
+        special::negate(arr);
+    } else if constexpr (multiplier.kind == MultiplierKind::POWER_OF_TWO) {
+        special::shiftLeft(arr, multiplier.shift);
+    } else {
+        LoopMultiplication::kernel(arr, static_cast<T>(K));
+    }
+}
+
+// Множитель известен только во время выполнения. true — умножение выполнено,
+// false — k общего вида, и умножать должна стратегия.
+template <typename T>
+bool multiplySpecial(ArrayView<T> arr, T k) {
+    MultiplierClass multiplier = classifyMultiplier(k);
+    switch (multiplier.kind) {
+        case MultiplierKind::ONE:
+            return true;
+        case MultiplierKind::ZERO:
+            if constexpr (std::is_integral<T>::value) {
+                special::fillZero(arr);
+            }
+            return true;
+        case MultiplierKind::MINUS_ONE:
+            special::negate(arr);
+            return true;
+        case MultiplierKind::POWER_OF_TWO:
+            if constexpr (std::is_integral<T>::value) {
+                special::shiftLeft(arr, multiplier.shift);
+            }
+            return true;
+        case MultiplierKind::GENERAL:
+            break;
+    }
+    return false;
+}
+
+// То же для совмещённого прохода MultiplicationStrategy::multiplyWithSum:
+// обе суммы и (если snapshot != nullptr) снимок исходных значений.
+// При k = 1 без снимка массив только читается.
+inline bool multiplySpecialWithSum(ArrayView<int> arr, int k, int* snapshot, MultiplyResult& result) {
+    MultiplierClass multiplier = classifyMultiplier(k);
+    if (multiplier.kind == MultiplierKind::GENERAL) {
+        return false;
+    }
+
+    int* data = arr.data();
+    size_t size = arr.size();
+    long long oldSum = 0;
+    long long newSum = 0;
+    auto transform = [&](auto op) {
+        for (size_t i = 0; i < size; i++) {
+            int value = data[i];
+            if (snapshot) {
+                snapshot[i] = value;
+            }
+            int product = op(value);
+            data[i] = product;
+            oldSum += value;
+            newSum += product;
+        }
+    };
+
+    switch (multiplier.kind) {
+        case MultiplierKind::ONE:
+            for (size_t i = 0; i < size; i++) {
+                oldSum += data[i];
+            }
+            if (snapshot) {
+                std::memcpy(snapshot, data, size * sizeof(int));
+            }
+            newSum = oldSum;
+            break;
+        case MultiplierKind::ZERO:
+            transform([](int) { return 0; });
+            break;
+        case MultiplierKind::MINUS_ONE:
+            transform([](int value) { return special::negate(value); });
+            break;
+        case MultiplierKind::POWER_OF_TWO:
+            transform([shift = multiplier.shift](int value) { return special::shiftLeft(value, shift); });
+            break;
+        case MultiplierKind::GENERAL:
+            break;
+    }
+    result.oldSum = oldSum;
+    result.newSum = newSum;
+    return true;
+}
+
+#endif // SPECIAL_MULTIPLIERS_H
@@ -0,0 +1,45 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+// Ограниченная очередь без блокировок для одного производителя и одного
+// потребителя. Индексы растут неограниченно, позиция — по маске ёмкости.
+// Производитель и потребитель пишут каждый в свой индекс, поэтому индексы
+// разнесены по разным кэш-линиям.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Ёмкость очереди должна быть степенью двойки");
+
+public:
+    // Только для потока-производителя. false — очередь заполнена.
+    bool tryPush(const T& value) {
+        size_t tailIndex = tail.load(std::memory_order_relaxed);
+        if (tailIndex - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[tailIndex & (Capacity - 1)] = value;
+        tail.store(tailIndex + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Только для потока-потребителя. false — очередь пуста.
+    bool tryPop(T& value) {
+        size_t headIndex = head.load(std::memory_order_relaxed);
+        if (tail.load(std::memory_order_acquire) == headIndex) {
+            return false;
+        }
+        value = slots[headIndex & (Capacity - 1)];
+        head.store(headIndex + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+    alignas(64) T slots[Capacity];
+};
+
+#endif // SPSC_QUEUE_H
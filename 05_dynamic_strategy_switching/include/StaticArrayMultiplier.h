@@ -0,0 +1,108 @@
+#ifndef STATIC_ARRAY_MULTIPLIER_H
+#define STATIC_ARRAY_MULTIPLIER_H
+
+#include <array>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include "MultiplicationStrategy.h"
+#include "SpecialMultipliers.h"
+
+// Умножитель с набором стратегий, известным при компиляции.
+// Стратегия хранится в std::variant, а не за указателем на базовый класс:
+// std::visit выбирает ветку по индексу (таблица переходов), внутри ветки
+// тип стратегии известен, и вызов идёт напрямую — kernel() простых
+// стратегий встраивается целиком. Тип элементов — любой, для которого
+// у стратегий есть kernel() (int, int64_t, float, double).
+//
+// Для стратегий, выбираемых во время выполнения (StrategyFactory, плагины),
+// остаётся виртуальный интерфейс MultiplicationStrategy.
+//
+// Пример: StaticArrayMultiplier<LoopMultiplication, SimdMultiplication> m;
+//         m.setStrategy<SimdMultiplication>();
+//         m.multiplyArray(arr, 3);
+template <typename... Strategies>
+class StaticArrayMultiplier {
+    static_assert(sizeof...(Strategies) > 0, "Нужна хотя бы одна стратегия");
+
+public:
+    // По умолчанию выбрана первая стратегия из списка
+    StaticArrayMultiplier() = default;
+
+    template <typename Strategy, typename... Args>
+    void setStrategy(Args&&... args) {
+        strategy.template emplace<Strategy>(std::forward<Args>(args)...);
+    }
+
+    template <typename Strategy>
+    bool holds() const {
+        return std::holds_alternative<Strategy>(strategy);
+    }
+
+    // k = 0, ±1, 2^n обрабатываются без стратегии (SpecialMultipliers.h)
+    template <typename T>
+    void multiplyArray(ArrayView<T> arr, T k) {
+        if (!multiplySpecial(arr, k)) {
+            std::visit([&](auto& s) { apply(s, arr, k); }, strategy);
+        }
+    }
+
+    // Множитель известен при компиляции: частный случай выбирается
+    // без проверок, общий — ядро стратегии с константой K
+    template <auto K, typename T>
+    void multiplyArray(ArrayView<T> arr) {
+        constexpr MultiplierKind kind = classifyMultiplier(static_cast<T>(K)).kind;
+        if constexpr (kind != MultiplierKind::GENERAL) {
+            multiplyByConstant<K>(arr);
+        } else {
+            std::visit([&](auto& s) { apply(s, arr, static_cast<T>(K)); }, strategy);
+        }
+    }
+
+    // std::vector и другие контейнеры — через неявное преобразование в ArrayView<int>
+    void multiplyArray(ArrayView<int> arr, int k) {
+        multiplyArray<int>(arr, k);
+    }
+
+    // Массив фиксированного размера: N известно при компиляции,
+    // и встроенный kernel() разворачивается под конкретную длину
+    template <typename T, size_t N>
+    void multiplyArray(std::array<T, N>& arr, T k) {
+        multiplyArray<T>(ArrayView<T>(arr.data(), N), k);
+    }
+
+    MultiplyResult multiplyWithSum(ArrayView<int> arr, int k, int* snapshot = nullptr) {
+        return std::visit([&](auto& s) { return s.multiplyWithSum(arr, k, snapshot); }, strategy);
+    }
+
+    std::string getName() const {
+        return std::visit([](const auto& s) { return s.getName(); }, strategy);
+    }
+
+private:
+    template <typename S, typename T, typename = void>
+    struct HasKernel : std::false_type {};
+
+    template <typename S, typename T>
+    struct HasKernel<S, T, std::void_t<decltype(std::declval<S&>().kernel(
+                               std::declval<ArrayView<T>>(), std::declval<T>()))>>
+        : std::true_type {};
+
+    // Стратегии без kernel() (например, подключённые извне) вызываются
+    // через multiply() — только для int
+    template <typename S, typename T>
+    static void apply(S& s, ArrayView<T> arr, T k) {
+        static_assert(std::is_final<S>::value,
+                      "Стратегия должна быть final, иначе вызов останется виртуальным");
+        if constexpr (HasKernel<S, T>::value) {
+            s.kernel(arr, k);
+        } else {
+            s.multiply(arr, k);
+        }
+    }
+
+    std::variant<Strategies...> strategy;
+};
+
+#endif // STATIC_ARRAY_MULTIPLIER_H
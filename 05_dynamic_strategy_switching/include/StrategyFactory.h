@@ -1,9 +1,13 @@
 #ifndef STRATEGY_FACTORY_H
 #define STRATEGY_FACTORY_H
 
+#include <cstddef>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <vector>
 #include "MultiplicationStrategy.h"
+#include "TypedStrategy.h"
 
 // Фабрика стратегий
 class StrategyFactory {
@@ -12,10 +16,25 @@ public:
         LOOP = 1,
         POINTERS = 2,
         TRANSFORM = 3,
-        RANGE = 4
+        RANGE = 4,
+        SIMD = 5,
+        PARALLEL = 6
     };
 
     static std::unique_ptr<MultiplicationStrategy> create(StrategyType type);
+    // Та же стратегия для массивов из T (int, int64_t, float, double)
+    template <typename T>
+    static std::unique_ptr<TypedMultiplicationStrategy<T>> createTyped(StrategyType type);
+    // Самая быстрая стратегия для массива из n элементов на этой машине.
+    // При первом вызове таблица «диапазон размеров → стратегия» читается из
+    // файла калибровки; если файла нет или он снят на другой машине,
+    // выполняется короткий замер всех стратегий и файл перезаписывается.
+    static std::unique_ptr<MultiplicationStrategy> createBest(size_t n);
+    static StrategyType bestType(size_t n);
+    // Файл калибровки: $STRATEGY_TUNING_FILE или .strategy_tuning в текущей папке
+    static std::string tuningFilePath();
+    // Все зарегистрированные типы в порядке номеров меню
+    static const std::vector<StrategyType>& allTypes();
     static void printAvailableStrategies();
 };
 
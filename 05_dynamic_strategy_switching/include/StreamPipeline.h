@@ -0,0 +1,35 @@
+#ifndef STREAM_PIPELINE_H
+#define STREAM_PIPELINE_H
+
+#include <cstddef>
+#include <string>
+#include "ArrayFile.h"
+#include "TypedStrategy.h"
+
+// Потоковое умножение двоичного файла массива (формат ArrayFile) без загрузки
+// его в память. Три стадии работают одновременно: чтение блока, умножение
+// предыдущего и запись ещё более раннего. Стадии связаны очередями SpscQueue,
+// блоки берутся из фиксированного набора буферов, поэтому пиковая память
+// равна STREAM_BUFFERS × chunkElements независимо от размера файла.
+struct StreamStats {
+    size_t elements = 0;
+    size_t chunks = 0;
+    double seconds = 0;         // общее время
+    double readSeconds = 0;     // время работы каждой стадии без ожиданий:
+    double computeSeconds = 0;  // самая загруженная стадия ограничивает
+    double writeSeconds = 0;    // пропускную способность конвейера
+};
+
+// По два буфера на каждую из трёх стадий: пока стадия обрабатывает один,
+// второй уже ждёт её в очереди
+const size_t STREAM_BUFFERS = 6;
+const size_t DEFAULT_STREAM_CHUNK = 1 << 18;  // элементов в блоке
+
+// Тип элементов T должен совпадать с типом в файле (reader.elementType()).
+// Определено для int, int64_t, float и double.
+template <typename T>
+StreamStats streamMultiplyFile(ArrayFileReader& reader, const std::string& outputPath,
+                               TypedMultiplicationStrategy<T>& strategy, T k,
+                               size_t chunkElements = DEFAULT_STREAM_CHUNK);
+
+#endif // STREAM_PIPELINE_H
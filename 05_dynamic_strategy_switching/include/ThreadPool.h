@@ -0,0 +1,52 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Постоянный пул потоков: создаётся один раз на процесс и переиспользуется.
+// Размер берётся из std::thread::hardware_concurrency().
+class ThreadPool {
+public:
+    static ThreadPool& instance();
+
+    explicit ThreadPool(size_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Выполняет task(0) ... task(taskCount - 1) и ждёт завершения всех задач.
+    // Вызывающий поток тоже берёт задачи, поэтому параллельность = size() + 1.
+    void parallelFor(size_t taskCount, const std::function<void(size_t)>& task);
+
+    size_t size() const { return workers.size(); }
+
+    // Привязывает фоновый поток index (0 .. size()-1) к ядру cpu.
+    // false — привязка не удалась или не поддерживается платформой.
+    bool pinWorker(size_t index, int cpu);
+
+private:
+    void workerLoop();
+    void runTasks();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable done;
+    std::mutex submitMutex;
+
+    const std::function<void(size_t)>* currentTask = nullptr;
+    size_t taskTotal = 0;
+    std::atomic<size_t> nextTask{0};
+    size_t activeWorkers = 0;
+    size_t generation = 0;
+    bool stopping = false;
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,52 @@
+#ifndef TYPED_STRATEGY_H
+#define TYPED_STRATEGY_H
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "ArrayView.h"
+
+// Интерфейс стратегии для произвольного типа элементов.
+// MultiplicationStrategy остаётся интерфейсом для int (история, совмещённый
+// проход с суммами); этот — для int64_t, float и double, в том числе над
+// чужой памятью: отображёнными файлами, частями массивов, буферами библиотек.
+template <typename T>
+class TypedMultiplicationStrategy {
+public:
+    using value_type = T;
+
+    virtual ~TypedMultiplicationStrategy() = default;
+    virtual void multiply(ArrayView<T> arr, T k) = 0;
+    virtual std::string getName() const = 0;
+};
+
+// Типы элементов, для которых у всех стратегий есть kernel()
+template <typename T>
+constexpr bool isSupportedElement = std::is_same<T, int>::value || std::is_same<T, int64_t>::value ||
+                                    std::is_same<T, float>::value || std::is_same<T, double>::value;
+
+// Типизированная стратегия поверх ядра стратегии из MultiplicationStrategy.h:
+// Strategy::kernel<T> уже специализирован по типу элементов, поэтому новые
+// классы на каждый тип не нужны.
+template <typename T, typename Strategy>
+class TypedStrategy final : public TypedMultiplicationStrategy<T> {
+    static_assert(isSupportedElement<T>, "Поддерживаются int, int64_t, float и double");
+
+public:
+    template <typename... Args>
+    explicit TypedStrategy(Args&&... args) : strategy(std::forward<Args>(args)...) {}
+
+    void multiply(ArrayView<T> arr, T k) override {
+        strategy.kernel(arr, k);
+    }
+
+    std::string getName() const override {
+        return strategy.getName();
+    }
+
+private:
+    Strategy strategy;
+};
+
+#endif // TYPED_STRATEGY_H
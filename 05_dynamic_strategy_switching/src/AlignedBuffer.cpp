@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "AlignedBuffer.h"
+#include "ThreadPool.h"
+
+namespace {
+
+size_t pageSize() {
+    static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+size_t roundUp(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+// Анонимное отображение с началом, кратным alignment: лишнее по краям
+// запаса снимается munmap
+char* mapAligned(size_t bytes, size_t alignment) {
+    size_t reserve = bytes + alignment - pageSize();
+    void* mapped = ::mmap(nullptr, reserve, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    char* base = static_cast<char*>(mapped);
+    char* start = reinterpret_cast<char*>(roundUp(reinterpret_cast<uintptr_t>(base), alignment));
+    if (start > base) {
+        ::munmap(base, static_cast<size_t>(start - base));
+    }
+    size_t tail = static_cast<size_t>(base + reserve - (start + bytes));
+    if (tail > 0) {
+        ::munmap(start + bytes, tail);
+    }
+    return start;
+}
+
+// Первое касание: по одной записи на страницу, страницы делятся на равные
+// куски по потокам пула (так же, как массив делит ParallelMultiplication)
+void touchPages(char* data, size_t bytes) {
+    size_t page = pageSize();
+    size_t pages = bytes / page;
+    ThreadPool& pool = ThreadPool::instance();
+    size_t parts = std::min(pages, pool.size() + 1);
+    size_t perPart = (pages + parts - 1) / parts;
+    pool.parallelFor(parts, [&](size_t part) {
+        size_t last = std::min(pages, (part + 1) * perPart);
+        for (size_t p = part * perPart; p < last; p++) {
+            data[p * page] = 0;
+        }
+    });
+}
+
+} // namespace
+
+void* allocateAligned(size_t bytes, const BufferOptions& options) {
+    if (bytes < HUGE_PAGE_SIZE) {
+        size_t alignment = std::max(options.alignment, sizeof(void*));
+        void* data = std::aligned_alloc(alignment, roundUp(bytes, alignment));
+        if (!data) {
+            throw std::bad_alloc();
+        }
+        if (options.zeroed) {
+            std::memset(data, 0, bytes);
+        }
+        return data;
+    }
+
+    // Анонимная память уже обнулена ядром, zeroed ничего не стоит
+    size_t length = roundUp(bytes, pageSize());
+    size_t alignment = std::max({options.alignment, pageSize(), options.hugePages ? HUGE_PAGE_SIZE : size_t{0}});
+    char* data = mapAligned(length, alignment);
+#ifdef MADV_HUGEPAGE
+    if (options.hugePages) {
+        // Подсказка: без поддержки THP в ядре вызов просто не сработает
+        ::madvise(data, length, MADV_HUGEPAGE);
+    }
+#endif
+    if (options.prefault) {
+        touchPages(data, length);
+    }
+    return data;
+}
+
+void freeAligned(void* data, size_t bytes) {
+    if (bytes < HUGE_PAGE_SIZE) {
+        std::free(data);
+    } else {
+        ::munmap(data, roundUp(bytes, pageSize()));
+    }
+}
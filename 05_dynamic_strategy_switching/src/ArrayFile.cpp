@@ -0,0 +1,343 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ArrayFile.h"
+
+namespace {
+
+const char ARRAY_FILE_MAGIC[8] = {'C', 'P', 'P', 'A', 'R', 'R', 'A', 'Y'};
+
+const uint64_t FNV_PRIME = 1099511628211ull;
+
+std::string systemError(const std::string& message, const std::string& path) {
+    return message + " " + path + ": " + std::strerror(errno);
+}
+
+void writeAll(int fd, const void* data, size_t bytes, const std::string& path) {
+    const char* ptr = static_cast<const char*>(data);
+    while (bytes > 0) {
+        ssize_t written = ::write(fd, ptr, bytes);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(systemError("Ошибка записи в файл", path));
+        }
+        ptr += written;
+        bytes -= static_cast<size_t>(written);
+    }
+}
+
+void readAll(int fd, void* data, size_t bytes, const std::string& path) {
+    char* ptr = static_cast<char*>(data);
+    while (bytes > 0) {
+        ssize_t got = ::read(fd, ptr, bytes);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(systemError("Ошибка чтения файла", path));
+        }
+        if (got == 0) {
+            throw std::runtime_error("Файл " + path + " обрывается раньше конца массива");
+        }
+        ptr += got;
+        bytes -= static_cast<size_t>(got);
+    }
+}
+
+ArrayFileHeader makeHeader(ElementType type, size_t count, uint64_t checksum, uint32_t flags) {
+    ArrayFileHeader header = {};
+    std::memcpy(header.magic, ARRAY_FILE_MAGIC, sizeof(header.magic));
+    header.version = ARRAY_FILE_VERSION;
+    header.elementType = static_cast<uint32_t>(type);
+    header.count = count;
+    header.checksum = checksum;
+    header.flags = flags;
+    return header;
+}
+
+// Пустая строка, если заголовок корректен и данных в файле хватает
+std::string headerProblem(const ArrayFileHeader& header, size_t fileSize) {
+    if (std::memcmp(header.magic, ARRAY_FILE_MAGIC, sizeof(header.magic)) != 0) {
+        return "не является файлом массива";
+    }
+    if (header.version != ARRAY_FILE_VERSION) {
+        return "имеет неподдерживаемую версию " + std::to_string(header.version);
+    }
+    if (header.elementType < static_cast<uint32_t>(ElementType::INT32) ||
+        header.elementType > static_cast<uint32_t>(ElementType::FLOAT64)) {
+        return "содержит элементы неизвестного типа " + std::to_string(header.elementType);
+    }
+    size_t itemSize = elementSize(static_cast<ElementType>(header.elementType));
+    if (header.count == 0 || header.count > (fileSize - sizeof(ArrayFileHeader)) / itemSize) {
+        return "повреждён: размер данных не совпадает с заголовком";
+    }
+    return "";
+}
+
+size_t fileSizeAtLeastHeader(int fd, const std::string& path) {
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(ArrayFileHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Файл " + path + " слишком мал для массива");
+    }
+    return static_cast<size_t>(info.st_size);
+}
+
+} // namespace
+
+size_t elementSize(ElementType type) {
+    switch (type) {
+        case ElementType::INT32:
+        case ElementType::FLOAT32:
+            return 4;
+        case ElementType::INT64:
+        case ElementType::FLOAT64:
+            return 8;
+    }
+    throw std::invalid_argument("Неизвестный тип элементов");
+}
+
+const char* elementTypeName(ElementType type) {
+    switch (type) {
+        case ElementType::INT32:
+            return "int32";
+        case ElementType::INT64:
+            return "int64";
+        case ElementType::FLOAT32:
+            return "float32";
+        case ElementType::FLOAT64:
+            return "float64";
+    }
+    return "unknown";
+}
+
+uint64_t arrayChecksum(const void* data, size_t bytes, uint64_t seed) {
+    const unsigned char* ptr = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed;
+    size_t words = bytes / sizeof(uint64_t);
+    for (size_t i = 0; i < words; i++) {
+        uint64_t word;
+        std::memcpy(&word, ptr + i * sizeof(uint64_t), sizeof(word));
+        hash = (hash ^ word) * FNV_PRIME;
+    }
+    for (size_t i = words * sizeof(uint64_t); i < bytes; i++) {
+        hash = (hash ^ ptr[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+void saveArrayFile(const std::string& path, ArrayView<const int> data) {
+    ArrayFileWriter writer(path, data.size());
+    writer.write(data);
+    writer.finish();
+}
+
+// Реализация ArrayFileReader
+ArrayFileReader::ArrayFileReader(const std::string& path) : filePath(path) {
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error(systemError("Не удалось открыть файл", path));
+    }
+    size_t fileSize = fileSizeAtLeastHeader(fd, path);
+
+    ArrayFileHeader header;
+    try {
+        readAll(fd, &header, sizeof(header), path);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    std::string problem = headerProblem(header, fileSize);
+    if (!problem.empty()) {
+        ::close(fd);
+        throw std::runtime_error("Файл " + path + " " + problem);
+    }
+    type = static_cast<ElementType>(header.elementType);
+    total = static_cast<size_t>(header.count);
+    storedChecksum = header.checksum;
+    clean = (header.flags & ARRAY_FILE_DIRTY) == 0;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+}
+
+ArrayFileReader::~ArrayFileReader() {
+    ::close(fd);
+}
+
+void ArrayFileReader::requireType(ElementType requested) const {
+    if (requested != type) {
+        throw std::logic_error("Файл " + filePath + " содержит " + elementTypeName(type) +
+                               ", а читается как " + elementTypeName(requested));
+    }
+}
+
+size_t ArrayFileReader::readElements(void* buffer, size_t count) {
+    size_t n = std::min(count, total - consumed);
+    readAll(fd, buffer, n * elementSize(type), filePath);
+    consumed += n;
+    return n;
+}
+
+// Реализация ArrayFileWriter
+ArrayFileWriter::ArrayFileWriter(const std::string& path, size_t count, ElementType type)
+    : filePath(path), type(type), total(count) {
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error(systemError("Не удалось создать файл", path));
+    }
+    // До finish() файл помечен как незавершённый
+    ArrayFileHeader header = makeHeader(type, count, 0, ARRAY_FILE_DIRTY);
+    try {
+        writeAll(fd, &header, sizeof(header), path);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+}
+
+ArrayFileWriter::~ArrayFileWriter() {
+    ::close(fd);
+}
+
+void ArrayFileWriter::requireType(ElementType requested) const {
+    if (requested != type) {
+        throw std::logic_error("Файл " + filePath + " создан для " + elementTypeName(type) +
+                               ", а записывается " + elementTypeName(requested));
+    }
+}
+
+void ArrayFileWriter::writeElements(const void* data, size_t count) {
+    if (written + count > total) {
+        throw std::logic_error("Запись за пределы массива в " + filePath);
+    }
+    size_t bytes = count * elementSize(type);
+    if (written + count < total && bytes % sizeof(uint64_t) != 0) {
+        throw std::logic_error("Промежуточный блок должен занимать целое число 8-байтных слов");
+    }
+    checksum = arrayChecksum(data, bytes, checksum);
+    writeAll(fd, data, bytes, filePath);
+    written += count;
+}
+
+void ArrayFileWriter::finish() {
+    if (written != total) {
+        throw std::logic_error("Массив в " + filePath + " записан не полностью");
+    }
+    ArrayFileHeader header = makeHeader(type, total, checksum, 0);
+    if (pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+        throw std::runtime_error(systemError("Ошибка записи заголовка в файл", filePath));
+    }
+}
+
+// Реализация MappedArray
+MappedArray MappedArray::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDWR);
+    if (fd < 0) {
+        throw std::runtime_error(systemError("Не удалось открыть файл", path));
+    }
+
+    size_t length = fileSizeAtLeastHeader(fd, path);
+
+    void* base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        std::string error = systemError("Не удалось отобразить файл", path);
+        ::close(fd);
+        throw std::runtime_error(error);
+    }
+
+    auto* header = static_cast<ArrayFileHeader*>(base);
+    std::string problem = headerProblem(*header, length);
+    if (problem.empty() && header->elementType != static_cast<uint32_t>(ElementType::INT32)) {
+        problem = "содержит элементы не типа int32";
+    }
+    if (!problem.empty()) {
+        munmap(base, length);
+        ::close(fd);
+        throw std::runtime_error("Файл " + path + " " + problem);
+    }
+
+    // Данные будут меняться на месте: до sync() контрольная сумма недействительна
+    bool clean = (header->flags & ARRAY_FILE_DIRTY) == 0;
+    header->flags |= ARRAY_FILE_DIRTY;
+
+    // Массив обычно проходится целиком и последовательно
+    madvise(base, length, MADV_SEQUENTIAL);
+    return MappedArray(path, fd, base, length, clean);
+}
+
+MappedArray::MappedArray(std::string path, int fd, void* base, size_t length, bool clean)
+    : filePath(std::move(path)), fd(fd), base(base), length(length), clean(clean) {}
+
+MappedArray::MappedArray(MappedArray&& other) noexcept
+    : filePath(std::move(other.filePath)), fd(other.fd), base(other.base),
+      length(other.length), clean(other.clean) {
+    other.fd = -1;
+    other.base = nullptr;
+    other.length = 0;
+}
+
+MappedArray& MappedArray::operator=(MappedArray&& other) noexcept {
+    if (this != &other) {
+        release();
+        filePath = std::move(other.filePath);
+        fd = other.fd;
+        base = other.base;
+        length = other.length;
+        clean = other.clean;
+        other.fd = -1;
+        other.base = nullptr;
+        other.length = 0;
+    }
+    return *this;
+}
+
+MappedArray::~MappedArray() {
+    release();
+}
+
+void MappedArray::release() {
+    if (base) {
+        munmap(base, length);
+        base = nullptr;
+    }
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+ArrayFileHeader* MappedArray::header() const {
+    return static_cast<ArrayFileHeader*>(base);
+}
+
+ArrayView<int> MappedArray::view() const {
+    int* data = reinterpret_cast<int*>(static_cast<char*>(base) + sizeof(ArrayFileHeader));
+    return ArrayView<int>(data, size());
+}
+
+size_t MappedArray::size() const {
+    return static_cast<size_t>(header()->count);
+}
+
+bool MappedArray::verify() const {
+    ArrayView<int> data = view();
+    return arrayChecksum(data.data(), data.size() * sizeof(int)) == header()->checksum;
+}
+
+void MappedArray::sync() {
+    ArrayView<int> data = view();
+    header()->checksum = arrayChecksum(data.data(), data.size() * sizeof(int));
+    header()->flags &= ~ARRAY_FILE_DIRTY;
+    if (msync(base, length, MS_SYNC) != 0) {
+        throw std::runtime_error(systemError("Ошибка сброса на диск файла", filePath));
+    }
+    clean = true;
+}
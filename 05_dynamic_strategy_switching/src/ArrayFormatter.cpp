@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <cstring>
+#include "ArrayFormatter.h"
+
+namespace {
+
+// Максимальная длина int/long long в десятичной записи со знаком
+constexpr size_t MAX_NUMBER_LENGTH = 20;
+
+} // namespace
+
+// Реализация ArrayFormatter
+ArrayFormatter::ArrayFormatter(std::ostream& out, size_t bufferSize)
+    : out(out), buffer(bufferSize < 256 ? 256 : bufferSize) {}
+
+ArrayFormatter::~ArrayFormatter() {
+    flush();
+}
+
+void ArrayFormatter::reserve(size_t bytes) {
+    if (used + bytes > buffer.size()) {
+        flush();
+    }
+}
+
+ArrayFormatter& ArrayFormatter::append(std::string_view text) {
+    while (!text.empty()) {
+        reserve(1);
+        size_t chunk = std::min(text.size(), buffer.size() - used);
+        std::memcpy(buffer.data() + used, text.data(), chunk);
+        used += chunk;
+        text.remove_prefix(chunk);
+    }
+    return *this;
+}
+
+ArrayFormatter& ArrayFormatter::append(long long value) {
+    reserve(MAX_NUMBER_LENGTH);
+    char* begin = buffer.data() + used;
+    used = std::to_chars(begin, begin + MAX_NUMBER_LENGTH, value).ptr - buffer.data();
+    return *this;
+}
+
+ArrayFormatter& ArrayFormatter::appendArray(const int* data, size_t size, std::string_view separator) {
+    // Быстрый путь: число и разделитель пишутся напрямую без проверок на каждом шаге
+    const size_t itemLength = MAX_NUMBER_LENGTH + separator.size();
+    for (size_t i = 0; i < size; i++) {
+        reserve(itemLength);
+        char* ptr = buffer.data() + used;
+        if (i > 0) {
+            std::memcpy(ptr, separator.data(), separator.size());
+            ptr += separator.size();
+        }
+        ptr = std::to_chars(ptr, ptr + MAX_NUMBER_LENGTH, data[i]).ptr;
+        used = ptr - buffer.data();
+    }
+    return *this;
+}
+
+void ArrayFormatter::flush() {
+    if (used > 0) {
+        out.write(buffer.data(), static_cast<std::streamsize>(used));
+        used = 0;
+    }
+}
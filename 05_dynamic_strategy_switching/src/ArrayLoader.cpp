@@ -0,0 +1,102 @@
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "ArrayLoader.h"
+
+namespace {
+
+// Таблица пробельных символов: одна загрузка вместо цепочки сравнений
+struct WhitespaceTable {
+    bool table[256] = {};
+    WhitespaceTable() {
+        for (unsigned char c : {' ', '\t', '\n', '\r', '\v', '\f'}) {
+            table[c] = true;
+        }
+    }
+};
+
+const char* skipWhitespace(const char* ptr, const char* end) {
+    static const WhitespaceTable whitespace;
+    while (ptr < end && whitespace.table[static_cast<unsigned char>(*ptr)]) {
+        ptr++;
+    }
+    return ptr;
+}
+
+template <typename T>
+const char* parseNumber(const char* ptr, const char* end, T& value, size_t index) {
+    ptr = skipWhitespace(ptr, end);
+    // from_chars не принимает '+', а ввод через std::cin принимал
+    if (ptr < end && *ptr == '+') {
+        ptr++;
+    }
+    auto [next, error] = std::from_chars(ptr, end, value);
+    if (error == std::errc::result_out_of_range) {
+        throw std::out_of_range("Число вне диапазона int (позиция " + std::to_string(index) + ")");
+    }
+    if (error != std::errc()) {
+        throw std::invalid_argument("Ошибка ввода данных (позиция " + std::to_string(index) + ")");
+    }
+    return next;
+}
+
+} // namespace
+
+AlignedBuffer<int> parseArray(std::string_view text) {
+    const char* ptr = text.data();
+    const char* end = ptr + text.size();
+
+    long long n;
+    ptr = parseNumber(ptr, end, n, 0);
+    if (n <= 0) {
+        throw std::invalid_argument("Размер массива должен быть больше 0");
+    }
+    // Каждый элемент занимает минимум 2 символа (цифра и разделитель)
+    if (static_cast<unsigned long long>(n) > text.size() / 2 + 1) {
+        throw std::invalid_argument("Во входных данных меньше элементов, чем заявлено");
+    }
+
+    AlignedBuffer<int> arr(static_cast<size_t>(n));
+    for (size_t i = 0; i < arr.size(); i++) {
+        ptr = parseNumber(ptr, end, arr[i], i + 1);
+    }
+    return arr;
+}
+
+AlignedBuffer<int> loadArrayFile(const std::string& path) {
+    std::unique_ptr<FILE, int (*)(FILE*)> file(std::fopen(path.c_str(), "rb"), std::fclose);
+    if (!file) {
+        throw std::runtime_error("Не удалось открыть файл " + path);
+    }
+    std::fseek(file.get(), 0, SEEK_END);
+    long size = std::ftell(file.get());
+    std::fseek(file.get(), 0, SEEK_SET);
+    if (size < 0) {
+        throw std::runtime_error("Не удалось определить размер файла " + path);
+    }
+
+    std::string buffer(static_cast<size_t>(size), '\0');
+    if (std::fread(buffer.data(), 1, buffer.size(), file.get()) != buffer.size()) {
+        throw std::runtime_error("Ошибка чтения файла " + path);
+    }
+    return parseArray(buffer);
+}
+
+AlignedBuffer<int> generateArray(size_t n, unsigned seed) {
+    if (n == 0) {
+        throw std::invalid_argument("Размер массива должен быть больше 0");
+    }
+    AlignedBuffer<int> arr(n);
+    // xorshift32: быстрее std::mt19937 и достаточно для синтетической нагрузки
+    uint32_t state = seed ? seed : 1;
+    for (auto& element : arr) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        element = static_cast<int>(state % 2001) - 1000;
+    }
+    return arr;
+}
@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "BatchMultiplier.h"
+#include "SpecialMultipliers.h"
+#include "ThreadPool.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Часть одного задания: элементы [begin, end) массива jobs[job]
+struct Piece {
+    size_t job;
+    size_t begin;
+    size_t end;
+};
+
+// Задача планировщика — подряд идущие части [firstPiece, lastPiece)
+struct Task {
+    size_t firstPiece;
+    size_t lastPiece;
+    size_t elements;
+};
+
+// Очередь задач одного потока — непрерывный отрезок индексов задач.
+// Обе границы упакованы в одно атомарное слово, поэтому и владелец
+// (берёт с начала), и воры (берут с конца) меняют отрезок одним CAS
+// без блокировок. Очереди разнесены по кэш-линиям.
+class alignas(64) TaskRange {
+public:
+    void assign(uint32_t begin, uint32_t end) {
+        bounds.store(pack(begin, end), std::memory_order_relaxed);
+    }
+
+    bool popFront(uint32_t& task) {
+        uint64_t current = bounds.load(std::memory_order_relaxed);
+        while (low(current) < high(current)) {
+            if (bounds.compare_exchange_weak(current, pack(low(current) + 1, high(current)),
+                                             std::memory_order_relaxed)) {
+                task = low(current);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool popBack(uint32_t& task) {
+        uint64_t current = bounds.load(std::memory_order_relaxed);
+        while (low(current) < high(current)) {
+            if (bounds.compare_exchange_weak(current, pack(low(current), high(current) - 1),
+                                             std::memory_order_relaxed)) {
+                task = high(current) - 1;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static uint64_t pack(uint32_t begin, uint32_t end) {
+        return static_cast<uint64_t>(end) << 32 | begin;
+    }
+    static uint32_t low(uint64_t value) { return static_cast<uint32_t>(value); }
+    static uint32_t high(uint64_t value) { return static_cast<uint32_t>(value >> 32); }
+
+    std::atomic<uint64_t> bounds{0};
+};
+
+// Большие задания режутся на части, мелкие остаются целыми.
+// Задания с k = 1 ничего не меняют и в задачи не попадают.
+std::vector<Piece> splitJobs(ArrayView<const BatchJob> jobs, BatchStats& stats) {
+    std::vector<Piece> pieces;
+    pieces.reserve(jobs.size());
+    for (size_t job = 0; job < jobs.size(); job++) {
+        if (jobs[job].k == 1) {
+            continue;
+        }
+        size_t size = jobs[job].array.size();
+        if (size > BATCH_SPLIT_ELEMENTS) {
+            stats.splitJobs++;
+        }
+        for (size_t begin = 0; begin < size; begin += BATCH_SPLIT_ELEMENTS) {
+            pieces.push_back({job, begin, std::min(size, begin + BATCH_SPLIT_ELEMENTS)});
+        }
+    }
+    return pieces;
+}
+
+// Подряд идущие части объединяются, пока задача меньше BATCH_GRAIN_ELEMENTS
+std::vector<Task> coalescePieces(const std::vector<Piece>& pieces) {
+    std::vector<Task> tasks;
+    size_t first = 0;
+    size_t elements = 0;
+    for (size_t i = 0; i < pieces.size(); i++) {
+        elements += pieces[i].end - pieces[i].begin;
+        if (elements >= BATCH_GRAIN_ELEMENTS || i + 1 == pieces.size()) {
+            tasks.push_back({first, i + 1, elements});
+            first = i + 1;
+            elements = 0;
+        }
+    }
+    return tasks;
+}
+
+} // namespace
+
+BatchStats multiplyBatch(ArrayView<const BatchJob> jobs) {
+    auto start = Clock::now();
+    BatchStats stats;
+    stats.jobs = jobs.size();
+    for (const BatchJob& job : jobs) {
+        if (!job.strategy) {
+            throw std::invalid_argument("Для задания пакета не указана стратегия");
+        }
+        stats.elements += job.array.size();
+    }
+
+    std::vector<Piece> pieces = splitJobs(jobs, stats);
+    std::vector<Task> tasks = coalescePieces(pieces);
+    stats.tasks = tasks.size();
+    if (tasks.size() > UINT32_MAX) {
+        throw std::length_error("Слишком много задач в пакете");
+    }
+
+    ThreadPool& pool = ThreadPool::instance();
+    size_t workers = std::max<size_t>(1, std::min(pool.size() + 1, tasks.size()));
+
+    // Начальное распределение: непрерывные отрезки задач с примерно
+    // равным числом элементов — соседние массивы остаются у одного потока
+    std::unique_ptr<TaskRange[]> ranges(new TaskRange[workers]);
+    size_t target = (stats.elements + workers - 1) / workers;
+    size_t begin = 0;
+    for (size_t w = 0; w < workers; w++) {
+        size_t end = begin;
+        size_t assigned = 0;
+        while (end < tasks.size() && (assigned < target || w + 1 == workers)) {
+            assigned += tasks[end++].elements;
+        }
+        ranges[w].assign(static_cast<uint32_t>(begin), static_cast<uint32_t>(end));
+        begin = end;
+    }
+
+    auto runTask = [&](uint32_t index) {
+        const Task& task = tasks[index];
+        for (size_t p = task.firstPiece; p < task.lastPiece; p++) {
+            const Piece& piece = pieces[p];
+            const BatchJob& job = jobs[piece.job];
+            ArrayView<int> part = job.array.subview(piece.begin, piece.end - piece.begin);
+            if (!multiplySpecial(part, job.k)) {
+                job.strategy->multiply(part, job.k);
+            }
+        }
+    };
+
+    std::atomic<size_t> steals{0};
+    pool.parallelFor(workers, [&](size_t self) {
+        uint32_t task;
+        while (ranges[self].popFront(task)) {
+            runTask(task);
+        }
+        // Своя очередь пуста — обходим чужие, начиная с соседа
+        bool found = true;
+        while (found) {
+            found = false;
+            for (size_t offset = 1; offset < workers; offset++) {
+                if (ranges[(self + offset) % workers].popBack(task)) {
+                    runTask(task);
+                    steals.fetch_add(1, std::memory_order_relaxed);
+                    found = true;
+                    break;
+                }
+            }
+        }
+    });
+
+    stats.steals = steals.load(std::memory_order_relaxed);
+    stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return stats;
+}
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "AlignedBuffer.h"
+#include "ArrayFile.h"
+#include "ChunkedArray.h"
+
+// Блок: данные либо в чужой памяти (base, нулевой блок), либо в собственной копии
+struct ChunkedArray::Chunk {
+    int* data = nullptr;
+    AlignedBuffer<int> owned;
+
+    Chunk() = default;
+    explicit Chunk(int* external) : data(external) {}
+    ~Chunk();
+
+    Chunk(const Chunk&) = delete;
+    Chunk& operator=(const Chunk&) = delete;
+};
+
+namespace {
+
+std::atomic<size_t> heapChunkCount{0};
+
+// Освобождённые буферы блоков переиспользуются: иначе каждая копия — новое
+// выделение 256 КиБ через mmap и первое касание каждой страницы
+const size_t SPARE_CHUNKS = 256;
+std::mutex spareMutex;
+std::vector<AlignedBuffer<int>> spareBuffers;
+
+// Новая копия блока без инициализации: её сразу заполняет memcpy.
+// Блоки выровнены по кэш-линии, как и большие массивы
+std::shared_ptr<ChunkedArray::Chunk> allocateChunk() {
+    auto chunk = std::make_shared<ChunkedArray::Chunk>();
+    {
+        std::lock_guard<std::mutex> lock(spareMutex);
+        if (!spareBuffers.empty()) {
+            chunk->owned = std::move(spareBuffers.back());
+            spareBuffers.pop_back();
+        }
+    }
+    if (chunk->owned.empty()) {
+        BufferOptions options;
+        options.zeroed = false;
+        chunk->owned = AlignedBuffer<int>(ChunkedArray::CHUNK_ELEMENTS, options);
+    }
+    chunk->data = chunk->owned.data();
+    heapChunkCount.fetch_add(1, std::memory_order_relaxed);
+    return chunk;
+}
+
+// Общий нулевой блок. Ссылка отсюда держит счётчик больше 1, поэтому
+// writable() всегда копирует его, а не пишет в него.
+const std::shared_ptr<ChunkedArray::Chunk>& zeroChunk() {
+    static AlignedBuffer<int> zeros(ChunkedArray::CHUNK_ELEMENTS);
+    static const std::shared_ptr<ChunkedArray::Chunk> chunk =
+        std::make_shared<ChunkedArray::Chunk>(zeros.data());
+    return chunk;
+}
+
+} // namespace
+
+ChunkedArray::Chunk::~Chunk() {
+    if (!owned.empty()) {
+        heapChunkCount.fetch_sub(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(spareMutex);
+        if (spareBuffers.size() < SPARE_CHUNKS) {
+            spareBuffers.push_back(std::move(owned));
+        }
+    }
+}
+
+// Реализация ChunkedArray
+ChunkedArray::ChunkedArray(ArrayView<int> base) : elements(base.size()) {
+    chunks.reserve((elements + CHUNK_ELEMENTS - 1) / CHUNK_ELEMENTS);
+    for (size_t offset = 0; offset < elements; offset += CHUNK_ELEMENTS) {
+        chunks.push_back(std::make_shared<Chunk>(base.data() + offset));
+    }
+}
+
+size_t ChunkedArray::chunkLength(size_t index) const {
+    return std::min(CHUNK_ELEMENTS, elements - index * CHUNK_ELEMENTS);
+}
+
+const int* ChunkedArray::chunkData(size_t index) const {
+    return chunks[index]->data;
+}
+
+int* ChunkedArray::writableData(size_t index) {
+    std::shared_ptr<Chunk>& chunk = chunks[index];
+    if (chunk.use_count() > 1) {
+        std::shared_ptr<Chunk> copy = allocateChunk();
+        std::memcpy(copy->data, chunk->data, chunkLength(index) * sizeof(int));
+        chunk = std::move(copy);
+    }
+    return chunk->data;
+}
+
+ArrayView<const int> ChunkedArray::chunk(size_t index) const {
+    return ArrayView<const int>(chunkData(index), chunkLength(index));
+}
+
+ArrayView<int> ChunkedArray::writable(size_t index) {
+    return ArrayView<int>(writableData(index), chunkLength(index));
+}
+
+bool ChunkedArray::isZero(size_t index) const {
+    return chunks[index] == zeroChunk();
+}
+
+void ChunkedArray::setZero(size_t index) {
+    chunks[index] = zeroChunk();
+}
+
+int ChunkedArray::at(size_t index) const {
+    return chunks[index / CHUNK_ELEMENTS]->data[index % CHUNK_ELEMENTS];
+}
+
+ChunkedArray::Version ChunkedArray::version() const {
+    Version version;
+    version.chunks = chunks;
+    version.elements = elements;
+    return version;
+}
+
+void ChunkedArray::restore(const Version& version) {
+    if (version.elements != elements) {
+        throw std::logic_error("Версия относится к массиву другого размера");
+    }
+    chunks = version.chunks;
+}
+
+void ChunkedArray::copyTo(ArrayView<int> target) const {
+    if (target.size() != elements) {
+        throw std::invalid_argument("Размер массива назначения не совпадает");
+    }
+    for (size_t i = 0; i < chunks.size(); i++) {
+        int* destination = target.data() + i * CHUNK_ELEMENTS;
+        if (chunkData(i) != destination) {
+            std::memcpy(destination, chunkData(i), chunkLength(i) * sizeof(int));
+        }
+    }
+}
+
+void ChunkedArray::save(const std::string& path) const {
+    ArrayFileWriter writer(path, elements);
+    // Куски состоят из целых блоков (кроме последнего), поэтому кратны 8 байтам
+    forEachRun([&](ArrayView<const int> run) {
+        writer.write(run);
+    });
+    writer.finish();
+}
+
+size_t ChunkedArray::ownedBytes() const {
+    size_t owned = 0;
+    for (const auto& chunk : chunks) {
+        if (!chunk->owned.empty()) {
+            owned++;
+        }
+    }
+    return owned * CHUNK_ELEMENTS * sizeof(int);
+}
+
+size_t ChunkedArray::heapBytes() {
+    return heapChunkCount.load(std::memory_order_relaxed) * CHUNK_ELEMENTS * sizeof(int);
+}
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include "EventSink.h"
+
+StrategyEvent::StrategyEvent(EventType type, const std::string& strategyName) : type(type) {
+    size_t length = std::min(strategyName.size(), NAME_CAPACITY - 1);
+    // Не разрезать многобайтовый символ: продолжения UTF-8 имеют вид 10xxxxxx
+    while (length < strategyName.size() && length > 0 &&
+           (static_cast<unsigned char>(strategyName[length]) & 0xC0) == 0x80) {
+        length--;
+    }
+    std::memcpy(strategy, strategyName.data(), length);
+    strategy[length] = '\0';
+}
+
+void ConsoleEventSink::emit(const StrategyEvent& event) {
+    switch (event.type) {
+        case EventType::STRATEGY_CHANGED:
+            out << "✓ Применена стратегия: " << event.strategy << "\n";
+            break;
+        case EventType::MULTIPLIED:
+            out << "Сумма до: " << event.oldSum << " → Сумма после: " << event.newSum
+                << (event.deferred ? " (отложено)" : "") << "\n";
+            break;
+        case EventType::UNDONE:
+            out << "✓ Отменена операция: " << event.strategy
+                << " с множителем " << event.multiplier << "\n";
+            break;
+        case EventType::NOTHING_TO_UNDO:
+            out << "❌ Нет операций для отмены" << "\n";
+            break;
+        case EventType::REDONE:
+            out << "✓ Повторена операция: " << event.strategy
+                << " с множителем " << event.multiplier << "\n";
+            break;
+        case EventType::NOTHING_TO_REDO:
+            out << "❌ Нет отменённых операций для повтора" << "\n";
+            break;
+        case EventType::CANCELLED:
+            out << "⏹ Фоновая операция отменена: " << event.strategy << " с множителем "
+                << event.multiplier << " (обработано элементов: " << event.elements << ", изменения откатаны)" << "\n";
+            break;
+    }
+}
+
+void ConsoleEventSink::flush() {
+    out.flush();
+}
+
+AsyncEventSink::AsyncEventSink(std::unique_ptr<EventSink> target)
+    : target(std::move(target)), consumer(&AsyncEventSink::run, this) {}
+
+AsyncEventSink::~AsyncEventSink() {
+    stopping.store(true, std::memory_order_release);
+    consumer.join();
+    target->flush();
+}
+
+void AsyncEventSink::emit(const StrategyEvent& event) {
+    if (queue.tryPush(event)) {
+        sent++;
+    } else {
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AsyncEventSink::flush() {
+    while (delivered.load(std::memory_order_acquire) != sent) {
+        std::this_thread::yield();
+    }
+    target->flush();
+}
+
+// События редки по сравнению с операциями, поэтому пустая очередь
+// не крутится в цикле, а проверяется раз в короткий интервал
+void AsyncEventSink::run() {
+    StrategyEvent event;
+    while (true) {
+        // Флаг читается до очереди: после остановки все события отправителя
+        // уже видны, и пустая очередь означает, что работа закончена
+        bool stop = stopping.load(std::memory_order_acquire);
+        if (queue.tryPop(event)) {
+            target->emit(event);
+            delivered.fetch_add(1, std::memory_order_release);
+        } else if (stop) {
+            break;
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+}
@@ -0,0 +1,99 @@
+#include <vector>
+#include <string>
+#include "MultiplicationStrategy.h"
+
+namespace {
+
+// Совмещённый проход на собственном ядре стратегии. Массив идёт кусками по
+// FUSED_BLOCK элементов, которые помещаются в L1: снимок и сумма до читают
+// кусок перед ядром, сумма после — сразу за ним, поэтому из памяти каждый
+// элемент загружается один раз.
+const size_t FUSED_BLOCK = 1024;
+
+template <typename Kernel>
+MultiplyResult multiplyWithKernel(ArrayView<int> arr, int* snapshot, Kernel kernel) {
+    MultiplyResult result;
+    for (size_t offset = 0; offset < arr.size(); offset += FUSED_BLOCK) {
+        ArrayView<int> block = arr.subview(offset, std::min(FUSED_BLOCK, arr.size() - offset));
+        if (snapshot) {
+            std::copy(block.begin(), block.end(), snapshot + offset);
+        }
+        for (int value : block) {
+            result.oldSum += value;
+        }
+        kernel(block);
+        for (int value : block) {
+            result.newSum += value;
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+// Реализация MultiplicationStrategy
+MultiplyResult MultiplicationStrategy::multiplyWithSum(ArrayView<int> arr, int k, int* snapshot) {
+    MultiplyResult result;
+    for (size_t i = 0; i < arr.size(); i++) {
+        int value = arr[i];
+        if (snapshot) {
+            snapshot[i] = value;
+        }
+        arr[i] = wrappingMultiply(value, k);
+        result.oldSum += value;
+        result.newSum += arr[i];
+    }
+    return result;
+}
+
+// Реализация LoopMultiplication
+void LoopMultiplication::multiply(ArrayView<int> arr, int k) {
+    kernel(arr, k);
+}
+
+MultiplyResult LoopMultiplication::multiplyWithSum(ArrayView<int> arr, int k, int* snapshot) {
+    return multiplyWithKernel(arr, snapshot, [k](ArrayView<int> block) { kernel(block, k); });
+}
+
+std::string LoopMultiplication::getName() const {
+    return "Умножение через цикл";
+}
+
+// Реализация PointerMultiplication
+void PointerMultiplication::multiply(ArrayView<int> arr, int k) {
+    kernel(arr, k);
+}
+
+MultiplyResult PointerMultiplication::multiplyWithSum(ArrayView<int> arr, int k, int* snapshot) {
+    return multiplyWithKernel(arr, snapshot, [k](ArrayView<int> block) { kernel(block, k); });
+}
+
+std::string PointerMultiplication::getName() const {
+    return "Умножение через указатели";
+}
+
+// Реализация TransformMultiplication
+void TransformMultiplication::multiply(ArrayView<int> arr, int k) {
+    kernel(arr, k);
+}
+
+MultiplyResult TransformMultiplication::multiplyWithSum(ArrayView<int> arr, int k, int* snapshot) {
+    return multiplyWithKernel(arr, snapshot, [k](ArrayView<int> block) { kernel(block, k); });
+}
+
+std::string TransformMultiplication::getName() const {
+    return "Умножение через std::transform";
+}
+
+// Реализация RangeMultiplication
+void RangeMultiplication::multiply(ArrayView<int> arr, int k) {
+    kernel(arr, k);
+}
+
+MultiplyResult RangeMultiplication::multiplyWithSum(ArrayView<int> arr, int k, int* snapshot) {
+    return multiplyWithKernel(arr, snapshot, [k](ArrayView<int> block) { kernel(block, k); });
+}
+
+std::string RangeMultiplication::getName() const {
+    return "Умножение через range-based for";
+}
@@ -0,0 +1,262 @@
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ArrayFile.h"
+#include "OperationJournal.h"
+
+namespace {
+
+const char JOURNAL_MAGIC[8] = {'C', 'P', 'P', 'J', 'R', 'N', 'L', '1'};
+
+struct JournalHeader {
+    char magic[8];
+    uint64_t generation;  // поколение контрольной точки, к которой относятся записи
+    uint8_t reserved[16];
+};
+
+static_assert(sizeof(JournalHeader) == 32, "Заголовок журнала должен занимать 32 байта");
+
+std::string systemError(const std::string& message, const std::string& path) {
+    return message + " " + path + ": " + std::strerror(errno);
+}
+
+uint32_t recordChecksum(const JournalRecord& record) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&record);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(JournalRecord, checksum); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+std::string checkpointPath(const std::string& path, uint64_t generation) {
+    return path + ".checkpoint-" + std::to_string(generation);
+}
+
+void writeAll(int fd, const void* data, size_t bytes, const std::string& path) {
+    const char* ptr = static_cast<const char*>(data);
+    while (bytes > 0) {
+        ssize_t written = ::write(fd, ptr, bytes);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(systemError("Ошибка записи в журнал", path));
+        }
+        ptr += written;
+        bytes -= static_cast<size_t>(written);
+    }
+}
+
+// Сбрасывает на диск файл или каталог
+void syncPath(const std::string& path, int flags) {
+    int fd = ::open(path.c_str(), flags);
+    if (fd < 0 || ::fsync(fd) != 0) {
+        std::string error = systemError("Не удалось сбросить на диск", path);
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        throw std::runtime_error(error);
+    }
+    ::close(fd);
+}
+
+std::string directoryOf(const std::string& path) {
+    size_t slash = path.rfind('/');
+    return slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+}
+
+// Атомарная замена: запись во временный файл, fsync, rename, fsync каталога.
+// После сбоя на диске либо старая версия файла, либо новая целиком.
+template <typename WriteContents>
+void replaceFile(const std::string& path, WriteContents writeContents) {
+    std::string temporary = path + ".tmp";
+    writeContents(temporary);
+    syncPath(temporary, O_RDONLY);
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error(systemError("Не удалось переименовать", temporary));
+    }
+    syncPath(directoryOf(path), O_RDONLY | O_DIRECTORY);
+}
+
+void writeJournalHeader(const std::string& path, uint64_t generation) {
+    JournalHeader header = {};
+    std::memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.generation = generation;
+
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error(systemError("Не удалось создать журнал", path));
+    }
+    try {
+        writeAll(fd, &header, sizeof(header), path);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+}
+
+// Контрольная точка поколения generation и новый пустой журнал к ней.
+// Порядок важен: пока журнал не заменён, действует старое поколение,
+// и его контрольная точка ещё на месте.
+void startGeneration(const std::string& path, uint64_t generation, const ChunkedArray& arr) {
+    replaceFile(checkpointPath(path, generation), [&](const std::string& temporary) {
+        arr.save(temporary);
+    });
+    replaceFile(path, [&](const std::string& temporary) {
+        writeJournalHeader(temporary, generation);
+    });
+    if (generation > 1) {
+        std::remove(checkpointPath(path, generation - 1).c_str());
+    }
+}
+
+} // namespace
+
+// Реализация OperationJournal
+bool OperationJournal::exists(const std::string& path) {
+    struct stat info;
+    return ::stat(path.c_str(), &info) == 0;
+}
+
+OperationJournal::Recovery OperationJournal::recover(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDWR);
+    if (fd < 0) {
+        throw std::runtime_error(systemError("Не удалось открыть журнал", path));
+    }
+    struct stat info;
+    JournalHeader header;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(header) ||
+        ::pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        std::memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Файл " + path + " не является журналом операций");
+    }
+
+    Recovery recovery;
+    size_t bytes = static_cast<size_t>(info.st_size) - sizeof(header);
+    std::vector<JournalRecord> stored(bytes / sizeof(JournalRecord));
+    if (!stored.empty()) {
+        ssize_t expected = static_cast<ssize_t>(stored.size() * sizeof(JournalRecord));
+        if (::pread(fd, stored.data(), static_cast<size_t>(expected), sizeof(header)) != expected) {
+            std::string error = systemError("Ошибка чтения журнала", path);
+            ::close(fd);
+            throw std::runtime_error(error);
+        }
+    }
+    // Записи принимаются до первой повреждённой или не по порядку
+    for (const JournalRecord& record : stored) {
+        if (record.checksum != recordChecksum(record) || record.sequence != recovery.records.size() ||
+            (record.type != JournalRecord::MULTIPLY && record.type != JournalRecord::UNDO)) {
+            break;
+        }
+        recovery.records.push_back(record);
+    }
+    size_t validBytes = sizeof(header) + recovery.records.size() * sizeof(JournalRecord);
+    recovery.discardedBytes = static_cast<size_t>(info.st_size) - validBytes;
+    if (recovery.discardedBytes > 0 && ::ftruncate(fd, static_cast<off_t>(validBytes)) != 0) {
+        std::string error = systemError("Не удалось отрезать повреждённый хвост журнала", path);
+        ::close(fd);
+        throw std::runtime_error(error);
+    }
+    ::close(fd);
+
+    std::string checkpoint = checkpointPath(path, header.generation);
+    ArrayFileReader reader(checkpoint);
+    recovery.array = AlignedBuffer<int>(reader.size());
+    size_t loaded = 0;
+    while (loaded < recovery.array.size()) {
+        loaded += reader.read(recovery.array.data() + loaded, recovery.array.size() - loaded);
+    }
+    if (!reader.wasClean() ||
+        arrayChecksum(recovery.array.data(), recovery.array.size() * sizeof(int)) != reader.checksum()) {
+        throw std::runtime_error("Контрольная точка " + checkpoint + " повреждена");
+    }
+    return recovery;
+}
+
+void OperationJournal::initialize(const std::string& path, const ChunkedArray& initial) {
+    startGeneration(path, 1, initial);
+}
+
+OperationJournal::OperationJournal(const std::string& path, size_t checkpointEvery)
+    : filePath(path), checkpointEvery(checkpointEvery) {
+    fd = ::open(path.c_str(), O_RDWR | O_APPEND);
+    if (fd < 0) {
+        throw std::runtime_error(systemError("Не удалось открыть журнал", path));
+    }
+    struct stat info;
+    JournalHeader header;
+    if (::fstat(fd, &info) != 0 ||
+        ::pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        std::memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) != 0 ||
+        (static_cast<size_t>(info.st_size) - sizeof(header)) % sizeof(JournalRecord) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Журнал " + path + " повреждён: сначала нужно восстановление");
+    }
+    currentGeneration = header.generation;
+    recordCount = (static_cast<size_t>(info.st_size) - sizeof(header)) / sizeof(JournalRecord);
+}
+
+OperationJournal::~OperationJournal() {
+    if (fd >= 0) {
+        if (unsynced > 0) {
+            ::fdatasync(fd);
+        }
+        ::close(fd);
+    }
+}
+
+void OperationJournal::logMultiply(int strategyType, int k) {
+    JournalRecord record = {};
+    record.type = JournalRecord::MULTIPLY;
+    record.strategy = static_cast<uint8_t>(strategyType);
+    record.k = k;
+    append(record);
+}
+
+void OperationJournal::logUndo() {
+    JournalRecord record = {};
+    record.type = JournalRecord::UNDO;
+    append(record);
+}
+
+void OperationJournal::append(JournalRecord record) {
+    record.sequence = static_cast<uint32_t>(recordCount);
+    record.checksum = recordChecksum(record);
+    writeAll(fd, &record, sizeof(record), filePath);
+    recordCount++;
+    if (++unsynced >= SYNC_BATCH) {
+        sync();
+    }
+}
+
+void OperationJournal::sync() {
+    if (unsynced == 0) {
+        return;
+    }
+    if (::fdatasync(fd) != 0) {
+        throw std::runtime_error(systemError("Не удалось сбросить журнал на диск", filePath));
+    }
+    unsynced = 0;
+}
+
+void OperationJournal::checkpoint(const ChunkedArray& arr) {
+    sync();
+    startGeneration(filePath, currentGeneration + 1, arr);
+
+    int newFd = ::open(filePath.c_str(), O_RDWR | O_APPEND);
+    if (newFd < 0) {
+        throw std::runtime_error(systemError("Не удалось открыть журнал", filePath));
+    }
+    ::close(fd);
+    fd = newFd;
+    currentGeneration++;
+    recordCount = 0;
+}
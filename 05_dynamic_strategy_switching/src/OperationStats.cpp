@@ -0,0 +1,111 @@
+#include <iomanip>
+#include <sstream>
+#include "OperationStats.h"
+
+namespace {
+
+// Длительность в удобных единицах: 850 нс, 12.4 мкс, 3.1 мс, 2.0 с
+std::string formatNs(double ns) {
+    const char* units[] = {"нс", "мкс", "мс", "с"};
+    int unit = 0;
+    while (ns >= 1000 && unit < 3) {
+        ns /= 1000;
+        unit++;
+    }
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(unit == 0 ? 0 : 1) << ns << " " << units[unit];
+    return out.str();
+}
+
+std::string escapeJson(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+} // namespace
+
+const char* operationName(Operation operation) {
+    switch (operation) {
+        case Operation::MULTIPLY:
+            return "multiply";
+        case Operation::SAVE_HISTORY:
+            return "saveHistory";
+        case Operation::UNDO:
+            return "undo";
+        case Operation::REDO:
+            return "redo";
+    }
+    return "unknown";
+}
+
+// Реализация TimingStats
+void TimingStats::record(uint64_t ns, size_t elementCount) {
+    calls++;
+    elements += elementCount;
+    totalNs += ns;
+    if (ns > maxNs) {
+        maxNs = ns;
+    }
+    size_t bucket = ns == 0 ? 0 : static_cast<size_t>(63 - __builtin_clzll(ns));
+    histogram[bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1]++;
+}
+
+// Реализация OperationStats
+TimingStats& OperationStats::slot(Operation operation, const std::string& strategy) {
+    return entries[{operation, strategy}];
+}
+
+void OperationStats::print(std::ostream& out) const {
+    if (entries.empty()) {
+        out << "Статистика пуста: операций ещё не было" << "\n";
+        return;
+    }
+    out << "\n=== СТАТИСТИКА ОПЕРАЦИЙ ===" << "\n";
+    for (const auto& [key, stats] : entries) {
+        if (stats.calls == 0) {
+            continue;
+        }
+        out << operationName(key.first) << " — " << key.second << "\n";
+        out << "  вызовов: " << stats.calls << ", элементов: " << stats.elements
+            << ", всего: " << formatNs(static_cast<double>(stats.totalNs))
+            << ", среднее: " << formatNs(static_cast<double>(stats.totalNs) / stats.calls)
+            << ", максимум: " << formatNs(static_cast<double>(stats.maxNs)) << "\n";
+        out << "  распределение:";
+        for (size_t i = 0; i < TimingStats::HISTOGRAM_BUCKETS; i++) {
+            if (stats.histogram[i] > 0) {
+                out << " <" << formatNs(static_cast<double>(uint64_t{2} << i)) << ": " << stats.histogram[i] << ";";
+            }
+        }
+        out << "\n";
+    }
+}
+
+void OperationStats::writeJson(std::ostream& out) const {
+    out << "{\n  \"histogram_bucket\": \"[2^i, 2^(i+1)) ns\",\n  \"operations\": [\n";
+    bool first = true;
+    for (const auto& [key, stats] : entries) {
+        if (stats.calls == 0) {
+            continue;
+        }
+        out << (first ? "" : ",\n");
+        first = false;
+        out << "    {\"operation\": \"" << operationName(key.first) << "\""
+            << ", \"strategy\": \"" << escapeJson(key.second) << "\""
+            << ", \"calls\": " << stats.calls
+            << ", \"elements\": " << stats.elements
+            << ", \"total_ns\": " << stats.totalNs
+            << ", \"max_ns\": " << stats.maxNs
+            << ", \"histogram\": [";
+        for (size_t i = 0; i < TimingStats::HISTOGRAM_BUCKETS; i++) {
+            out << (i ? ", " : "") << stats.histogram[i];
+        }
+        out << "]}";
+    }
+    out << "\n  ]\n}\n";
+}
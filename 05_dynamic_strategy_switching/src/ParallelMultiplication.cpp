@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MultiplicationStrategy.h"
+#include "SimdKernels.h"
+#include "ThreadPool.h"
+
+namespace {
+
+constexpr size_t CACHE_LINE = 64;
+
+// Разбиение массива на куски, границы которых (кроме краёв) лежат на кэш-линиях
+struct ChunkPlan {
+    size_t head;      // элементов до первой границы кэш-линии
+    size_t chunkSize; // кратен числу элементов в кэш-линии
+    size_t count;
+
+    size_t begin(size_t index) const { return index == 0 ? 0 : head + index * chunkSize; }
+    size_t end(size_t index, size_t size) const { return std::min(size, head + (index + 1) * chunkSize); }
+};
+
+template <typename T>
+ChunkPlan planChunks(const T* data, size_t size, size_t parallelism) {
+    constexpr size_t perLine = CACHE_LINE / sizeof(T);
+    size_t misalignment = (reinterpret_cast<uintptr_t>(data) % CACHE_LINE) / sizeof(T);
+    size_t head = std::min(size, (perLine - misalignment) % perLine);
+    size_t body = size - head;
+
+    size_t chunkSize = (body + parallelism - 1) / parallelism;
+    chunkSize = (chunkSize + perLine - 1) / perLine * perLine;
+    chunkSize = std::max(chunkSize, perLine);
+
+    size_t count = std::max<size_t>(1, (body + chunkSize - 1) / chunkSize);
+    return {head, chunkSize, count};
+}
+
+} // namespace
+
+// Реализация ParallelMultiplication
+ParallelMultiplication::ParallelMultiplication(size_t threshold)
+    : threshold(threshold) {}
+
+template <typename T>
+void ParallelMultiplication::kernel(ArrayView<T> arr, T k) const {
+    ThreadPool& pool = ThreadPool::instance();
+    if (arr.size() < threshold || pool.size() == 0) {
+        simdMultiply(arr.data(), arr.size(), k);
+        return;
+    }
+
+    T* data = arr.data();
+    size_t size = arr.size();
+    ChunkPlan plan = planChunks(data, size, pool.size() + 1);
+
+    pool.parallelFor(plan.count, [&](size_t index) {
+        size_t begin = plan.begin(index);
+        simdMultiply(data + begin, plan.end(index, size) - begin, k);
+    });
+}
+
+template void ParallelMultiplication::kernel<int>(ArrayView<int>, int) const;
+template void ParallelMultiplication::kernel<int64_t>(ArrayView<int64_t>, int64_t) const;
+template void ParallelMultiplication::kernel<float>(ArrayView<float>, float) const;
+template void ParallelMultiplication::kernel<double>(ArrayView<double>, double) const;
+
+void ParallelMultiplication::multiply(ArrayView<int> arr, int k) {
+    kernel(arr, k);
+}
+
+MultiplyResult ParallelMultiplication::multiplyWithSum(ArrayView<int> arr, int k, int* snapshot) {
+    ThreadPool& pool = ThreadPool::instance();
+    if (arr.size() < threshold || pool.size() == 0) {
+        return simdMultiplyWithSum(arr.data(), arr.size(), k, snapshot);
+    }
+
+    int* data = arr.data();
+    size_t size = arr.size();
+    ChunkPlan plan = planChunks(data, size, pool.size() + 1);
+    std::vector<MultiplyResult> partial(plan.count);
+
+    pool.parallelFor(plan.count, [&](size_t index) {
+        size_t begin = plan.begin(index);
+        partial[index] = simdMultiplyWithSum(data + begin, plan.end(index, size) - begin, k,
+                                             snapshot ? snapshot + begin : nullptr);
+    });
+
+    MultiplyResult result;
+    for (const auto& part : partial) {
+        result.oldSum += part.oldSum;
+        result.newSum += part.newSum;
+    }
+    return result;
+}
+
+std::string ParallelMultiplication::getName() const {
+    return "Параллельное умножение (" + std::to_string(ThreadPool::instance().size() + 1) + " потоков)";
+}
+
+size_t ParallelMultiplication::getThreshold() const {
+    return threshold;
+}
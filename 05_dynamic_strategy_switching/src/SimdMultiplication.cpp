@@ -0,0 +1,435 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MultiplicationStrategy.h"
+#include "SimdKernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1
+// Интринсики AVX-512 в GCC 12 используют _mm*_undefined_*() и дают ложные
+// предупреждения -Wmaybe-uninitialized после встраивания
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+
+using MultiplyKernel = void (*)(int*, size_t, int);
+using FusedKernel = MultiplyResult (*)(int*, size_t, int, int*);
+
+// Скалярное ядро: используется для головы/хвоста и на CPU без SIMD.
+// Целые переполняются по модулю 2^N (wrappingMultiply) — так же, как
+// считают SIMD-ядра, поэтому результат не зависит от выбранного пути.
+template <typename T>
+void multiplyScalar(T* data, size_t size, T k) {
+    for (size_t i = 0; i < size; i++) {
+        data[i] = wrappingMultiply(data[i], k);
+    }
+}
+
+template <bool WithSnapshot>
+MultiplyResult fusedScalar(int* data, size_t size, int k, int* snapshot) {
+    MultiplyResult result;
+    for (size_t i = 0; i < size; i++) {
+        int value = data[i];
+        if (WithSnapshot) {
+            snapshot[i] = value;
+        }
+        int product = wrappingMultiply(value, k);
+        data[i] = product;
+        result.oldSum += value;
+        result.newSum += product;
+    }
+    return result;
+}
+
+MultiplyResult multiplyWithSumScalar(int* data, size_t size, int k, int* snapshot) {
+    return snapshot ? fusedScalar<true>(data, size, k, snapshot)
+                    : fusedScalar<false>(data, size, k, nullptr);
+}
+
+void accumulate(MultiplyResult& total, const MultiplyResult& part) {
+    total.oldSum += part.oldSum;
+    total.newSum += part.newSum;
+}
+
+// Сколько элементов нужно обработать скалярно, чтобы дойти до границы alignment байт
+size_t headLength(const int* data, size_t size, size_t alignment) {
+    size_t misalignment = reinterpret_cast<uintptr_t>(data) & (alignment - 1);
+    if (misalignment == 0) {
+        return 0;
+    }
+    size_t head = (alignment - misalignment) / sizeof(int);
+    return head < size ? head : size;
+}
+
+#ifdef SIMD_X86
+
+// SSE4.1: 4 элемента за инструкцию, голова и хвост — скалярно
+__attribute__((target("sse4.1")))
+void multiplySse41(int* data, size_t size, int k) {
+    size_t i = headLength(data, size, 16);
+    multiplyScalar(data, i, k);
+
+    const __m128i factor = _mm_set1_epi32(k);
+    for (; i + 8 <= size; i += 8) {
+        __m128i* p = reinterpret_cast<__m128i*>(data + i);
+        __m128i a = _mm_load_si128(p);
+        __m128i b = _mm_load_si128(p + 1);
+        _mm_store_si128(p, _mm_mullo_epi32(a, factor));
+        _mm_store_si128(p + 1, _mm_mullo_epi32(b, factor));
+    }
+    for (; i + 4 <= size; i += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(data + i);
+        _mm_store_si128(p, _mm_mullo_epi32(_mm_load_si128(p), factor));
+    }
+
+    multiplyScalar(data + i, size - i, k);
+}
+
+// AVX2: 8 элементов за инструкцию, хвост — через маскированные load/store
+__attribute__((target("avx2")))
+void multiplyAvx2(int* data, size_t size, int k) {
+    size_t i = headLength(data, size, 32);
+    multiplyScalar(data, i, k);
+
+    const __m256i factor = _mm256_set1_epi32(k);
+    for (; i + 32 <= size; i += 32) {
+        __m256i* p = reinterpret_cast<__m256i*>(data + i);
+        __m256i a = _mm256_load_si256(p);
+        __m256i b = _mm256_load_si256(p + 1);
+        __m256i c = _mm256_load_si256(p + 2);
+        __m256i d = _mm256_load_si256(p + 3);
+        _mm256_store_si256(p, _mm256_mullo_epi32(a, factor));
+        _mm256_store_si256(p + 1, _mm256_mullo_epi32(b, factor));
+        _mm256_store_si256(p + 2, _mm256_mullo_epi32(c, factor));
+        _mm256_store_si256(p + 3, _mm256_mullo_epi32(d, factor));
+    }
+    for (; i + 8 <= size; i += 8) {
+        __m256i* p = reinterpret_cast<__m256i*>(data + i);
+        _mm256_store_si256(p, _mm256_mullo_epi32(_mm256_load_si256(p), factor));
+    }
+
+    size_t tail = size - i;
+    if (tail > 0) {
+        // Маска: старший бит установлен у первых tail элементов
+        const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(tail)), lanes);
+        __m256i v = _mm256_maskload_epi32(data + i, mask);
+        _mm256_maskstore_epi32(data + i, mask, _mm256_mullo_epi32(v, factor));
+    }
+}
+
+// AVX-512: 16 элементов за инструкцию, голова и хвост — через маски k-регистров
+__attribute__((target("avx512f")))
+void multiplyAvx512(int* data, size_t size, int k) {
+    const __m512i factor = _mm512_set1_epi32(k);
+
+    size_t i = headLength(data, size, 64);
+    if (i > 0) {
+        __mmask16 head = static_cast<__mmask16>((1u << i) - 1);
+        __m512i v = _mm512_maskz_loadu_epi32(head, data);
+        _mm512_mask_storeu_epi32(data, head, _mm512_mullo_epi32(v, factor));
+    }
+
+    for (; i + 64 <= size; i += 64) {
+        __m512i a = _mm512_load_si512(data + i);
+        __m512i b = _mm512_load_si512(data + i + 16);
+        __m512i c = _mm512_load_si512(data + i + 32);
+        __m512i d = _mm512_load_si512(data + i + 48);
+        _mm512_store_si512(data + i, _mm512_mullo_epi32(a, factor));
+        _mm512_store_si512(data + i + 16, _mm512_mullo_epi32(b, factor));
+        _mm512_store_si512(data + i + 32, _mm512_mullo_epi32(c, factor));
+        _mm512_store_si512(data + i + 48, _mm512_mullo_epi32(d, factor));
+    }
+    for (; i + 16 <= size; i += 16) {
+        _mm512_store_si512(data + i, _mm512_mullo_epi32(_mm512_load_si512(data + i), factor));
+    }
+
+    size_t tail = size - i;
+    if (tail > 0) {
+        __mmask16 mask = static_cast<__mmask16>((1u << tail) - 1);
+        __m512i v = _mm512_maskz_loadu_epi32(mask, data + i);
+        _mm512_mask_storeu_epi32(data + i, mask, _mm512_mullo_epi32(v, factor));
+    }
+}
+
+// Совмещённое AVX2-ядро: суммы накапливаются в 64-битных линиях
+template <bool WithSnapshot>
+__attribute__((target("avx2")))
+MultiplyResult fusedAvx2(int* data, size_t size, int k, int* snapshot) {
+    size_t i = headLength(data, size, 32);
+    MultiplyResult result = multiplyWithSumScalar(data, i, k, WithSnapshot ? snapshot : nullptr);
+
+    const __m256i factor = _mm256_set1_epi32(k);
+    __m256i oldAcc = _mm256_setzero_si256();
+    __m256i newAcc = _mm256_setzero_si256();
+    for (; i + 8 <= size; i += 8) {
+        __m256i* p = reinterpret_cast<__m256i*>(data + i);
+        __m256i value = _mm256_load_si256(p);
+        if (WithSnapshot) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(snapshot + i), value);
+        }
+        __m256i product = _mm256_mullo_epi32(value, factor);
+        _mm256_store_si256(p, product);
+
+        oldAcc = _mm256_add_epi64(oldAcc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(value)));
+        oldAcc = _mm256_add_epi64(oldAcc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(value, 1)));
+        newAcc = _mm256_add_epi64(newAcc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(product)));
+        newAcc = _mm256_add_epi64(newAcc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(product, 1)));
+    }
+
+    alignas(32) long long lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), oldAcc);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes + 4), newAcc);
+    result.oldSum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    result.newSum += lanes[4] + lanes[5] + lanes[6] + lanes[7];
+
+    accumulate(result, multiplyWithSumScalar(data + i, size - i, k, WithSnapshot ? snapshot + i : nullptr));
+    return result;
+}
+
+__attribute__((target("avx2")))
+MultiplyResult multiplyWithSumAvx2(int* data, size_t size, int k, int* snapshot) {
+    return snapshot ? fusedAvx2<true>(data, size, k, snapshot)
+                    : fusedAvx2<false>(data, size, k, nullptr);
+}
+
+// Совмещённое AVX-512-ядро
+template <bool WithSnapshot>
+__attribute__((target("avx512f")))
+MultiplyResult fusedAvx512(int* data, size_t size, int k, int* snapshot) {
+    size_t i = headLength(data, size, 64);
+    MultiplyResult result = multiplyWithSumScalar(data, i, k, WithSnapshot ? snapshot : nullptr);
+
+    const __m512i factor = _mm512_set1_epi32(k);
+    __m512i oldAcc = _mm512_setzero_si512();
+    __m512i newAcc = _mm512_setzero_si512();
+    for (; i + 16 <= size; i += 16) {
+        __m512i value = _mm512_load_si512(data + i);
+        if (WithSnapshot) {
+            _mm512_storeu_si512(snapshot + i, value);
+        }
+        __m512i product = _mm512_mullo_epi32(value, factor);
+        _mm512_store_si512(data + i, product);
+
+        oldAcc = _mm512_add_epi64(oldAcc, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(value)));
+        oldAcc = _mm512_add_epi64(oldAcc, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(value, 1)));
+        newAcc = _mm512_add_epi64(newAcc, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(product)));
+        newAcc = _mm512_add_epi64(newAcc, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(product, 1)));
+    }
+    result.oldSum += _mm512_reduce_add_epi64(oldAcc);
+    result.newSum += _mm512_reduce_add_epi64(newAcc);
+
+    accumulate(result, multiplyWithSumScalar(data + i, size - i, k, WithSnapshot ? snapshot + i : nullptr));
+    return result;
+}
+
+__attribute__((target("avx512f")))
+MultiplyResult multiplyWithSumAvx512(int* data, size_t size, int k, int* snapshot) {
+    return snapshot ? fusedAvx512<true>(data, size, k, snapshot)
+                    : fusedAvx512<false>(data, size, k, nullptr);
+}
+
+// Ядра для int64_t, float и double: основной цикл — невыровненные
+// load/store (на выровненных данных они не медленнее), хвост — по маске
+
+__attribute__((target("avx2")))
+void multiplyFloatAvx2(float* data, size_t size, float k) {
+    const __m256 factor = _mm256_set1_ps(k);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), factor));
+    }
+    size_t tail = size - i;
+    if (tail > 0) {
+        const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(tail)), lanes);
+        __m256 v = _mm256_maskload_ps(data + i, mask);
+        _mm256_maskstore_ps(data + i, mask, _mm256_mul_ps(v, factor));
+    }
+}
+
+__attribute__((target("avx2")))
+void multiplyDoubleAvx2(double* data, size_t size, double k) {
+    const __m256d factor = _mm256_set1_pd(k);
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        _mm256_storeu_pd(data + i, _mm256_mul_pd(_mm256_loadu_pd(data + i), factor));
+    }
+    size_t tail = size - i;
+    if (tail > 0) {
+        const __m256i lanes = _mm256_setr_epi64x(0, 1, 2, 3);
+        const __m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(tail)), lanes);
+        __m256d v = _mm256_maskload_pd(data + i, mask);
+        _mm256_maskstore_pd(data + i, mask, _mm256_mul_pd(v, factor));
+    }
+}
+
+__attribute__((target("avx512f")))
+void multiplyFloatAvx512(float* data, size_t size, float k) {
+    const __m512 factor = _mm512_set1_ps(k);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        _mm512_storeu_ps(data + i, _mm512_mul_ps(_mm512_loadu_ps(data + i), factor));
+    }
+    size_t tail = size - i;
+    if (tail > 0) {
+        __mmask16 mask = static_cast<__mmask16>((1u << tail) - 1);
+        _mm512_mask_storeu_ps(data + i, mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, data + i), factor));
+    }
+}
+
+__attribute__((target("avx512f")))
+void multiplyDoubleAvx512(double* data, size_t size, double k) {
+    const __m512d factor = _mm512_set1_pd(k);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        _mm512_storeu_pd(data + i, _mm512_mul_pd(_mm512_loadu_pd(data + i), factor));
+    }
+    size_t tail = size - i;
+    if (tail > 0) {
+        __mmask8 mask = static_cast<__mmask8>((1u << tail) - 1);
+        _mm512_mask_storeu_pd(data + i, mask, _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, data + i), factor));
+    }
+}
+
+// 64-битное умножение целых векторами есть только в AVX-512DQ
+__attribute__((target("avx512f,avx512dq")))
+void multiplyInt64Avx512(int64_t* data, size_t size, int64_t k) {
+    const __m512i factor = _mm512_set1_epi64(k);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        __m512i v = _mm512_loadu_si512(data + i);
+        _mm512_storeu_si512(data + i, _mm512_mullo_epi64(v, factor));
+    }
+    size_t tail = size - i;
+    if (tail > 0) {
+        __mmask8 mask = static_cast<__mmask8>((1u << tail) - 1);
+        __m512i v = _mm512_maskz_loadu_epi64(mask, data + i);
+        _mm512_mask_storeu_epi64(data + i, mask, _mm512_mullo_epi64(v, factor));
+    }
+}
+
+#endif // SIMD_X86
+
+// Для SSE4.1 отдельного совмещённого ядра нет: выигрыш даёт сам единый проход
+struct KernelChoice {
+    MultiplyKernel kernel;
+    FusedKernel fused;
+    const char* name;
+};
+
+KernelChoice selectKernel() {
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return {multiplyAvx512, multiplyWithSumAvx512, "AVX-512"};
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return {multiplyAvx2, multiplyWithSumAvx2, "AVX2"};
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return {multiplySse41, multiplyWithSumScalar, "SSE4.1"};
+    }
+#endif
+    return {multiplyScalar<int>, multiplyWithSumScalar, "scalar"};
+}
+
+const KernelChoice& activeKernel() {
+    static const KernelChoice choice = selectKernel();
+    return choice;
+}
+
+template <typename T>
+using TypedKernel = void (*)(T*, size_t, T);
+
+TypedKernel<int64_t> selectInt64Kernel() {
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512dq")) {
+        return multiplyInt64Avx512;
+    }
+#endif
+    return multiplyScalar<int64_t>;
+}
+
+TypedKernel<float> selectFloatKernel() {
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return multiplyFloatAvx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return multiplyFloatAvx2;
+    }
+#endif
+    return multiplyScalar<float>;
+}
+
+TypedKernel<double> selectDoubleKernel() {
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return multiplyDoubleAvx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return multiplyDoubleAvx2;
+    }
+#endif
+    return multiplyScalar<double>;
+}
+
+} // namespace
+
+void simdMultiply(int* data, size_t size, int k) {
+    activeKernel().kernel(data, size, k);
+}
+
+MultiplyResult simdMultiplyWithSum(int* data, size_t size, int k, int* snapshot) {
+    return activeKernel().fused(data, size, k, snapshot);
+}
+
+const char* simdInstructionSet() {
+    return activeKernel().name;
+}
+
+void simdMultiply(int64_t* data, size_t size, int64_t k) {
+    static const TypedKernel<int64_t> kernel = selectInt64Kernel();
+    kernel(data, size, k);
+}
+
+void simdMultiply(float* data, size_t size, float k) {
+    static const TypedKernel<float> kernel = selectFloatKernel();
+    kernel(data, size, k);
+}
+
+void simdMultiply(double* data, size_t size, double k) {
+    static const TypedKernel<double> kernel = selectDoubleKernel();
+    kernel(data, size, k);
+}
+
+// Реализация SimdMultiplication
+template <typename T>
+void SimdMultiplication::kernel(ArrayView<T> arr, T k) {
+    simdMultiply(arr.data(), arr.size(), k);
+}
+
+template void SimdMultiplication::kernel<int>(ArrayView<int>, int);
+template void SimdMultiplication::kernel<int64_t>(ArrayView<int64_t>, int64_t);
+template void SimdMultiplication::kernel<float>(ArrayView<float>, float);
+template void SimdMultiplication::kernel<double>(ArrayView<double>, double);
+
+void SimdMultiplication::multiply(ArrayView<int> arr, int k) {
+    simdMultiply(arr.data(), arr.size(), k);
+}
+
+MultiplyResult SimdMultiplication::multiplyWithSum(ArrayView<int> arr, int k, int* snapshot) {
+    return simdMultiplyWithSum(arr.data(), arr.size(), k, snapshot);
+}
+
+std::string SimdMultiplication::getName() const {
+    return std::string("Умножение через SIMD (") + simdInstructionSet() + ")";
+}
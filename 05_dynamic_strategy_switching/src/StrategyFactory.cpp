@@ -0,0 +1,78 @@
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "StrategyFactory.h"
+
+// Реализация StrategyFactory
+std::unique_ptr<MultiplicationStrategy> StrategyFactory::create(StrategyType type) {
+    switch (type) {
+        case LOOP:
+            return std::make_unique<LoopMultiplication>();
+        case POINTERS:
+            return std::make_unique<PointerMultiplication>();
+        case TRANSFORM:
+            return std::make_unique<TransformMultiplication>();
+        case RANGE:
+            return std::make_unique<RangeMultiplication>();
+        case SIMD:
+            return std::make_unique<SimdMultiplication>();
+        case PARALLEL:
+            return std::make_unique<ParallelMultiplication>();
+        default:
+            throw std::invalid_argument("Неизвестный тип стратегии");
+    }
+}
+
+template <typename T>
+std::unique_ptr<TypedMultiplicationStrategy<T>> StrategyFactory::createTyped(StrategyType type) {
+    switch (type) {
+        case LOOP:
+            return std::make_unique<TypedStrategy<T, LoopMultiplication>>();
+        case POINTERS:
+            return std::make_unique<TypedStrategy<T, PointerMultiplication>>();
+        case TRANSFORM:
+            return std::make_unique<TypedStrategy<T, TransformMultiplication>>();
+        case RANGE:
+            return std::make_unique<TypedStrategy<T, RangeMultiplication>>();
+        case SIMD:
+            return std::make_unique<TypedStrategy<T, SimdMultiplication>>();
+        case PARALLEL:
+            return std::make_unique<TypedStrategy<T, ParallelMultiplication>>();
+        default:
+            throw std::invalid_argument("Неизвестный тип стратегии");
+    }
+}
+
+template std::unique_ptr<TypedMultiplicationStrategy<int>> StrategyFactory::createTyped<int>(StrategyType);
+template std::unique_ptr<TypedMultiplicationStrategy<int64_t>> StrategyFactory::createTyped<int64_t>(StrategyType);
+template std::unique_ptr<TypedMultiplicationStrategy<float>> StrategyFactory::createTyped<float>(StrategyType);
+template std::unique_ptr<TypedMultiplicationStrategy<double>> StrategyFactory::createTyped<double>(StrategyType);
+
+const std::vector<StrategyFactory::StrategyType>& StrategyFactory::allTypes() {
+    static const std::vector<StrategyType> types = {LOOP, POINTERS, TRANSFORM, RANGE, SIMD, PARALLEL};
+    return types;
+}
+
+void StrategyFactory::printAvailableStrategies() {
+    std::cout << "\n=== ДОСТУПНЫЕ СТРАТЕГИИ ===" << "\n";
+    std::cout << "1 - Умножение через цикл" << "\n";
+    std::cout << "2 - Умножение через указатели" << "\n";
+    std::cout << "3 - Умножение через std::transform" << "\n";
+    std::cout << "4 - Умножение через range-based for" << "\n";
+    std::cout << "5 - Умножение через SIMD (SSE4.1/AVX2/AVX-512)" << "\n";
+    std::cout << "6 - Параллельное умножение на пуле потоков" << "\n";
+    std::cout << "auto - Самая быстрая стратегия для этого размера массива" << "\n";
+    std::cout << "=== КОМАНДЫ ===" << "\n";
+    std::cout << "undo - Отменить последнюю операцию" << "\n";
+    std::cout << "redo - Повторить отменённую операцию" << "\n";
+    std::cout << "history - Показать историю операций" << "\n";
+    std::cout << "stats - Показать статистику времени операций" << "\n";
+    std::cout << "print - Вывести массив целиком" << "\n";
+    std::cout << "export <файл> - Сохранить массив в двоичный файл" << "\n";
+    std::cout << "lazy - Включить/выключить ленивое умножение" << "\n";
+    std::cout << "bg <стратегия> <k> - Умножить в фоне (REPL не блокируется)" << "\n";
+    std::cout << "cancel - Отменить фоновые операции" << "\n";
+    std::cout << "wait - Дождаться фоновых операций" << "\n";
+    std::cout << "exit - Выход из программы" << "\n";
+}
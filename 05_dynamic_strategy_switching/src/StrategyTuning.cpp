@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "StrategyFactory.h"
+#include "SimdKernels.h"
+#include "ThreadPool.h"
+
+namespace {
+
+// v2: замеры multiplyWithSum вместо multiply, таблицы v1 пересчитываются
+const char* TUNING_HEADER = "# strategy tuning v2";
+
+// Строка таблицы: массивы до maxSize элементов включительно → стратегия
+struct TuningRow {
+    size_t maxSize;
+    StrategyFactory::StrategyType type;
+};
+
+struct TuningTable {
+    std::string machine;
+    std::vector<TuningRow> rows;
+};
+
+// Размеры замеров: от L1 до далеко за пределами LLC
+const size_t PROBE_SIZES[] = {size_t{1} << 10, size_t{1} << 14, size_t{1} << 18, size_t{1} << 22};
+
+// Подпись машины: модель CPU, выбранный SIMD и число потоков пула.
+// Таблица с другой подписью считается устаревшей.
+std::string machineSignature() {
+    std::string model = "unknown";
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 10, "model name") == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                model = line.substr(line.find_first_not_of(' ', colon + 1));
+            }
+            break;
+        }
+    }
+    return model + " | " + simdInstructionSet() + " | " + std::to_string(ThreadPool::instance().size() + 1);
+}
+
+// Замеряется тот же путь, что выполняет ArrayMultiplier: умножение вместе с
+// суммами (multiplyWithSum). k = 3 не частный множитель: k = -1 и степени
+// двойки до стратегии не доходят. Переполнение при повторах безопасно.
+double timeStrategy(MultiplicationStrategy& strategy, std::vector<int>& arr) {
+    // Маленькие массивы повторяются, чтобы замер был длиннее разрешения часов
+    size_t inner = std::max<size_t>(1, (size_t{1} << 20) / arr.size());
+    double best = std::numeric_limits<double>::max();
+    for (int rep = 0; rep < 5; rep++) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < inner; i++) {
+            strategy.multiplyWithSum(arr, 3, nullptr);
+        }
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+    return best;
+}
+
+TuningTable calibrate(const std::string& machine) {
+    TuningTable table;
+    table.machine = machine;
+
+    const size_t probeCount = sizeof(PROBE_SIZES) / sizeof(PROBE_SIZES[0]);
+    for (size_t p = 0; p < probeCount; p++) {
+        std::vector<int> arr(PROBE_SIZES[p]);
+        for (size_t i = 0; i < arr.size(); i++) {
+            arr[i] = static_cast<int>(i % 1000) - 500;
+        }
+
+        StrategyFactory::StrategyType best = StrategyFactory::LOOP;
+        double bestTime = std::numeric_limits<double>::max();
+        for (auto type : StrategyFactory::allTypes()) {
+            auto strategy = StrategyFactory::create(type);
+            double time = timeStrategy(*strategy, arr);
+            if (time < bestTime) {
+                bestTime = time;
+                best = type;
+            }
+        }
+
+        // Граница диапазона — середина (в геометрическом смысле) до следующего замера
+        size_t maxSize = p + 1 < probeCount ? PROBE_SIZES[p] * 4 - 1 : std::numeric_limits<size_t>::max();
+        table.rows.push_back({maxSize, best});
+    }
+    return table;
+}
+
+bool loadTable(const std::string& path, TuningTable& table) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != TUNING_HEADER) {
+        return false;
+    }
+    if (!std::getline(in, line) || line.compare(0, 8, "machine ") != 0) {
+        return false;
+    }
+    table.machine = line.substr(8);
+
+    const auto& known = StrategyFactory::allTypes();
+    while (std::getline(in, line)) {
+        std::istringstream row(line);
+        std::string maxSize;
+        int type;
+        if (!(row >> maxSize >> type) ||
+            std::find(known.begin(), known.end(), type) == known.end()) {
+            return false;
+        }
+        size_t limit = maxSize == "max" ? std::numeric_limits<size_t>::max()
+                                        : static_cast<size_t>(std::strtoull(maxSize.c_str(), nullptr, 10));
+        table.rows.push_back({limit, static_cast<StrategyFactory::StrategyType>(type)});
+    }
+    return !table.rows.empty() && table.rows.back().maxSize == std::numeric_limits<size_t>::max();
+}
+
+void saveTable(const std::string& path, const TuningTable& table) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Не удалось сохранить калибровку в " << path << std::endl;
+        return;
+    }
+    out << TUNING_HEADER << "\n";
+    out << "machine " << table.machine << "\n";
+    for (const auto& row : table.rows) {
+        if (row.maxSize == std::numeric_limits<size_t>::max()) {
+            out << "max";
+        } else {
+            out << row.maxSize;
+        }
+        out << " " << static_cast<int>(row.type) << "\n";
+    }
+}
+
+const TuningTable& tuningTable() {
+    static std::mutex mutex;
+    static TuningTable table;
+    static bool ready = false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!ready) {
+        std::string path = StrategyFactory::tuningFilePath();
+        std::string machine = machineSignature();
+        if (!loadTable(path, table) || table.machine != machine) {
+            table = calibrate(machine);
+            saveTable(path, table);
+        }
+        ready = true;
+    }
+    return table;
+}
+
+} // namespace
+
+// Реализация автовыбора стратегии
+std::string StrategyFactory::tuningFilePath() {
+    const char* path = std::getenv("STRATEGY_TUNING_FILE");
+    return path && *path ? path : ".strategy_tuning";
+}
+
+StrategyFactory::StrategyType StrategyFactory::bestType(size_t n) {
+    for (const auto& row : tuningTable().rows) {
+        if (n <= row.maxSize) {
+            return row.type;
+        }
+    }
+    return LOOP;
+}
+
+std::unique_ptr<MultiplicationStrategy> StrategyFactory::createBest(size_t n) {
+    return create(bestType(n));
+}
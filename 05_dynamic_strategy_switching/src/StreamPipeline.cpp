@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "ArrayFile.h"
+#include "SpecialMultipliers.h"
+#include "SpscQueue.h"
+#include "StreamPipeline.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Блок в пути между стадиями: номер буфера и число элементов в нём.
+// Блок с count == 0 означает конец потока.
+struct Chunk {
+    size_t buffer = 0;
+    size_t count = 0;
+};
+
+// Ёмкость не меньше числа буферов: очередь никогда не переполняется
+using ChunkQueue = SpscQueue<Chunk, 8>;
+static_assert(STREAM_BUFFERS <= 8, "Очередь должна вмещать все буферы");
+
+// Сколько раз опросить очередь перед тем, как заснуть
+const unsigned SPIN_LIMIT = 64;
+
+// Очередь между стадиями. Ожидающая стадия недолго опрашивает её, а потом
+// засыпает на changed: пока другая стадия ждёт диска, ожидание не занимает
+// ядро, нужное пулу потоков для умножения.
+struct StageQueue {
+    ChunkQueue chunks;
+    std::mutex mutex;
+    std::condition_variable changed;
+
+    // Будит стадию, заснувшую на этой очереди. Захват mutex не даёт
+    // уведомлению проскочить между её проверкой очереди и сном.
+    void wake() {
+        { std::lock_guard<std::mutex> lock(mutex); }
+        changed.notify_all();
+    }
+};
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Повторяет attempt, пока он не удастся: SPIN_LIMIT раз подряд, затем
+// засыпая между попытками. false — другая стадия завершилась с ошибкой.
+template <typename Attempt>
+bool waitFor(StageQueue& queue, const std::atomic<bool>& failed, Attempt attempt) {
+    for (unsigned spins = 0; spins < SPIN_LIMIT; spins++) {
+        if (attempt()) {
+            return true;
+        }
+        if (failed.load(std::memory_order_relaxed)) {
+            return false;
+        }
+    }
+    bool done = false;
+    std::unique_lock<std::mutex> lock(queue.mutex);
+    queue.changed.wait(lock, [&] { return (done = attempt()) || failed.load(); });
+    return done;
+}
+
+// Ждёт блок из очереди. false — другая стадия завершилась с ошибкой.
+bool popChunk(StageQueue& queue, Chunk& chunk, const std::atomic<bool>& failed) {
+    if (!waitFor(queue, failed, [&] { return queue.chunks.tryPop(chunk); })) {
+        return false;
+    }
+    queue.wake();
+    return true;
+}
+
+void pushChunk(StageQueue& queue, const Chunk& chunk, const std::atomic<bool>& failed) {
+    if (waitFor(queue, failed, [&] { return queue.chunks.tryPush(chunk); })) {
+        queue.wake();
+    }
+}
+
+} // namespace
+
+template <typename T>
+StreamStats streamMultiplyFile(ArrayFileReader& reader, const std::string& outputPath,
+                               TypedMultiplicationStrategy<T>& strategy, T k, size_t chunkElements) {
+    // Блоки из целых 8-байтных слов: по ним считается контрольная сумма
+    constexpr size_t perWord = sizeof(uint64_t) / sizeof(T);
+    chunkElements = std::max(perWord, (chunkElements + perWord - 1) / perWord * perWord);
+
+    // Выходной файл создаётся до запуска стадий, чтобы ошибки были видны сразу
+    ArrayFileWriter writer(outputPath, reader.size(), ElementTypeOf<T>::value);
+
+    std::unique_ptr<T[]> storage(new T[STREAM_BUFFERS * chunkElements]);
+    auto bufferData = [&](size_t buffer) { return storage.get() + buffer * chunkElements; };
+
+    StageQueue freeChunks;   // запись → чтение
+    StageQueue readChunks;   // чтение → умножение
+    StageQueue doneChunks;   // умножение → запись
+    std::atomic<bool> failed{false};
+    for (size_t i = 0; i < STREAM_BUFFERS; i++) {
+        pushChunk(freeChunks, Chunk{i, 0}, failed);
+    }
+    // Ошибка стадии будит остальные, даже если они спят на очередях
+    auto fail = [&] {
+        failed = true;
+        for (StageQueue* queue : {&freeChunks, &readChunks, &doneChunks}) {
+            queue->wake();
+        }
+    };
+
+    std::exception_ptr readError, computeError, writeError;
+    StreamStats stats;
+    stats.elements = reader.size();
+    auto start = Clock::now();
+
+    std::thread readStage([&] {
+        try {
+            Chunk chunk;
+            while (popChunk(freeChunks, chunk, failed)) {
+                auto busy = Clock::now();
+                chunk.count = reader.read(bufferData(chunk.buffer), chunkElements);
+                stats.readSeconds += secondsSince(busy);
+                pushChunk(readChunks, chunk, failed);
+                if (chunk.count == 0) {
+                    break;
+                }
+            }
+        } catch (...) {
+            readError = std::current_exception();
+            fail();
+        }
+    });
+
+    std::thread writeStage([&] {
+        try {
+            Chunk chunk;
+            while (popChunk(doneChunks, chunk, failed) && chunk.count > 0) {
+                auto busy = Clock::now();
+                writer.write(ArrayView<const T>(bufferData(chunk.buffer), chunk.count));
+                stats.writeSeconds += secondsSince(busy);
+                stats.chunks++;
+                pushChunk(freeChunks, chunk, failed);
+            }
+            if (!failed) {
+                writer.finish();
+            }
+        } catch (...) {
+            writeError = std::current_exception();
+            fail();
+        }
+    });
+
+    // Умножение идёт в вызывающем потоке: параллельная стратегия
+    // раздаёт блок пулу ThreadPool как обычно
+    try {
+        Chunk chunk;
+        while (popChunk(readChunks, chunk, failed)) {
+            if (chunk.count > 0) {
+                auto busy = Clock::now();
+                ArrayView<T> block(bufferData(chunk.buffer), chunk.count);
+                if (!multiplySpecial(block, k)) {
+                    strategy.multiply(block, k);
+                }
+                stats.computeSeconds += secondsSince(busy);
+            }
+            pushChunk(doneChunks, chunk, failed);
+            if (chunk.count == 0) {
+                break;
+            }
+        }
+    } catch (...) {
+        computeError = std::current_exception();
+        fail();
+    }
+
+    readStage.join();
+    writeStage.join();
+    for (const auto& error : {readError, computeError, writeError}) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    stats.seconds = secondsSince(start);
+    return stats;
+}
+
+template StreamStats streamMultiplyFile<int>(ArrayFileReader&, const std::string&,
+                                             TypedMultiplicationStrategy<int>&, int, size_t);
+template StreamStats streamMultiplyFile<int64_t>(ArrayFileReader&, const std::string&,
+                                                 TypedMultiplicationStrategy<int64_t>&, int64_t, size_t);
+template StreamStats streamMultiplyFile<float>(ArrayFileReader&, const std::string&,
+                                               TypedMultiplicationStrategy<float>&, float, size_t);
+template StreamStats streamMultiplyFile<double>(ArrayFileReader&, const std::string&,
+                                                TypedMultiplicationStrategy<double>&, double, size_t);
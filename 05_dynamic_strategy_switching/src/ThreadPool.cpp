@@ -0,0 +1,114 @@
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "ThreadPool.h"
+
+namespace {
+
+// Поток сейчас выполняет задачу пула. Вложенный parallelFor из такой задачи
+// (например, ParallelMultiplication внутри multiplyBatch) выполняется
+// последовательно: пул уже занят внешней партией и ждал бы сам себя.
+thread_local bool insideTask = false;
+
+} // namespace
+
+// Реализация ThreadPool
+ThreadPool& ThreadPool::instance() {
+    // Вызывающий поток тоже работает, поэтому фоновых потоков на один меньше
+    static ThreadPool pool([] {
+        unsigned hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? static_cast<size_t>(hardware - 1) : size_t{0};
+    }());
+    return pool;
+}
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t taskCount, const std::function<void(size_t)>& task) {
+    if (taskCount == 0) {
+        return;
+    }
+    if (workers.empty() || taskCount == 1 || insideTask) {
+        for (size_t i = 0; i < taskCount; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    // Пул обслуживает одну партию задач за раз
+    std::lock_guard<std::mutex> submit(submitMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentTask = &task;
+        taskTotal = taskCount;
+        nextTask.store(0, std::memory_order_relaxed);
+        activeWorkers = workers.size();
+        generation++;
+    }
+    wakeUp.notify_all();
+
+    runTasks();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return activeWorkers == 0; });
+    currentTask = nullptr;
+}
+
+bool ThreadPool::pinWorker(size_t index, int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(workers.at(index).native_handle(), sizeof(set), &set) == 0;
+#else
+    (void)index;
+    (void)cpu;
+    return false;
+#endif
+}
+
+void ThreadPool::workerLoop() {
+    size_t seenGeneration = 0;
+    while (true) {
+        std::unique_lock<std::mutex> lock(mutex);
+        wakeUp.wait(lock, [&] { return stopping || generation != seenGeneration; });
+        if (stopping) {
+            return;
+        }
+        seenGeneration = generation;
+        lock.unlock();
+
+        runTasks();
+
+        lock.lock();
+        if (--activeWorkers == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runTasks() {
+    insideTask = true;
+    size_t index;
+    while ((index = nextTask.fetch_add(1, std::memory_order_relaxed)) < taskTotal) {
+        (*currentTask)(index);
+    }
+    insideTask = false;
+}
@@ -1,170 +1,869 @@
 #include <iostream>
+#include <fstream>
 #include <vector>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <sstream>
 #include <algorithm>
+#include <cctype>
 #include <deque>
+#include <map>
+#include <climits>
+#include <limits>
+#include <type_traits>
+#include <optional>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <filesystem>
+#include <system_error>
 #include "MultiplicationStrategy.h"
 #include "StrategyFactory.h"
 #include "OperationHistory.h"
+#include "ChunkedArray.h"
+#include "AlignedBuffer.h"
+#include "OperationStats.h"
+#include "ArrayLoader.h"
+#include "ArrayFormatter.h"
+#include "ArrayFile.h"
+#include "StreamPipeline.h"
+#include "EventSink.h"
+#include "SpecialMultipliers.h"
+#include "OperationJournal.h"
+#include "AsyncMultiply.h"
 
 // Реализация OperationHistory
-OperationHistory::OperationHistory(const std::string& name, int k, const std::vector<int>& state)
-    : strategyName(name), multiplier(k), previousState(state) {}
+OperationHistory::OperationHistory(const std::string& name, int type, int k)
+    : strategyName(name), strategyType(type), multiplier(k) {}
 
-// Реализация LoopMultiplication
-void LoopMultiplication::multiply(std::vector<int>& arr, int k) {
-    for (size_t i = 0; i < arr.size(); i++) {
-        arr[i] *= k;
+OperationHistory::OperationHistory(const std::string& name, int type, int k, ChunkedArray::Version state)
+    : strategyName(name), strategyType(type), multiplier(k), previousState(std::move(state)) {}
+
+// Вспомогательные функции для отмены без снимка
+
+// Диапазон значений массива
+struct ValueRange {
+    int min = INT_MAX;
+    int max = INT_MIN;
+};
+
+ValueRange findValueRange(ArrayView<const int> arr) {
+    ValueRange range;
+    for (int value : arr) {
+        range.min = std::min(range.min, value);
+        range.max = std::max(range.max, value);
     }
+    return range;
 }
 
-std::string LoopMultiplication::getName() const {
-    return "Умножение через цикл";
+ValueRange findValueRange(const ChunkedArray& arr, size_t first, size_t last) {
+    ValueRange range;
+    arr.forEachRun(first, last, [&](ArrayView<const int> run) {
+        ValueRange part = findValueRange(run);
+        range.min = std::min(range.min, part.min);
+        range.max = std::max(range.max, part.max);
+    });
+    return range;
 }
 
-// Реализация PointerMultiplication
-void PointerMultiplication::multiply(std::vector<int>& arr, int k) {
-    int* ptr = arr.data();
-    int* end = ptr + arr.size();
-    
-    while (ptr < end) {
-        *ptr *= k;
-        ptr++;
-    }
+ValueRange findValueRange(const ChunkedArray& arr) {
+    return findValueRange(arr, 0, arr.chunkCount());
 }
 
-std::string PointerMultiplication::getName() const {
-    return "Умножение через указатели";
+// Помещается ли каждый элемент из range, умноженный на factor, в int
+bool fitsAfterMultiply(const ValueRange& range, long long factor) {
+    if (range.min > range.max || factor == 0) {
+        return true;
+    }
+    long long a, b;
+    if (__builtin_mul_overflow(static_cast<long long>(range.min), factor, &a) ||
+        __builtin_mul_overflow(static_cast<long long>(range.max), factor, &b)) {
+        return false;
+    }
+    return std::min(a, b) >= INT_MIN && std::max(a, b) <= INT_MAX;
 }
 
-// Реализация TransformMultiplication
-void TransformMultiplication::multiply(std::vector<int>& arr, int k) {
-    std::transform(arr.begin(), arr.end(), arr.begin(),
-                  [k](int x) { return x * k; });
+// Умножение на нечётное k точно обратимо без проверки элементов: по модулю 2^32
+// (так умножают SIMD-ядра) у него есть обратный, и divideArrayExact восстанавливает
+// элемент даже после переполнения. Чётное k теряет старшие биты: оно обратимо,
+// только если ни один элемент не переполнится (fitsAfterMultiply).
+bool isAlwaysInvertible(int k) {
+    return (k & 1) != 0;
 }
 
-std::string TransformMultiplication::getName() const {
-    return "Умножение через std::transform";
-}
+// Точное деление на k на месте без инструкции деления: k = 2^s * odd,
+// сдвиг на s и умножение на обратный к odd по модулю 2^32.
+// Корректно, только если k делит каждый элемент.
+void divideArrayExact(ArrayView<int> arr, int k) {
+    unsigned shift = 0;
+    while (((static_cast<unsigned>(k) >> shift) & 1u) == 0) {
+        shift++;
+    }
+    unsigned odd = static_cast<unsigned>(k >> shift);
+
+    // Метод Ньютона: каждая итерация удваивает число верных бит обратного
+    unsigned inverse = odd;
+    for (int i = 0; i < 4; i++) {
+        inverse *= 2u - odd * inverse;
+    }
 
-// Реализация RangeMultiplication
-void RangeMultiplication::multiply(std::vector<int>& arr, int k) {
     for (auto& element : arr) {
-        element *= k;
+        element = static_cast<int>(static_cast<unsigned>(element >> shift) * inverse);
     }
 }
 
-std::string RangeMultiplication::getName() const {
-    return "Умножение через range-based for";
+// Вспомогательные функции
+long long sumArrayWithPointers(ArrayView<const int> arr);
+
+long long sumChunks(const ChunkedArray& arr, size_t first, size_t last) {
+    long long sum = 0;
+    arr.forEachRun(first, last, [&](ArrayView<const int> run) {
+        sum += sumArrayWithPointers(run);
+    });
+    return sum;
 }
 
-// Реализация StrategyFactory
-std::unique_ptr<MultiplicationStrategy> StrategyFactory::create(StrategyType type) {
-    switch (type) {
-        case LOOP:
-            return std::make_unique<LoopMultiplication>();
-        case POINTERS:
-            return std::make_unique<PointerMultiplication>();
-        case TRANSFORM:
-            return std::make_unique<TransformMultiplication>();
-        case RANGE:
-            return std::make_unique<RangeMultiplication>();
-        default:
-            throw std::invalid_argument("Неизвестный тип стратегии");
-    }
+long long sumArray(const ChunkedArray& arr) {
+    return sumChunks(arr, 0, arr.chunkCount());
 }
 
-void StrategyFactory::printAvailableStrategies() {
-    std::cout << "\n=== ДОСТУПНЫЕ СТРАТЕГИИ ===" << std::endl;
-    std::cout << "1 - Умножение через цикл" << std::endl;
-    std::cout << "2 - Умножение через указатели" << std::endl;
-    std::cout << "3 - Умножение через std::transform" << std::endl;
-    std::cout << "4 - Умножение через range-based for" << std::endl;
-    std::cout << "=== КОМАНДЫ ===" << std::endl;
-    std::cout << "undo - Отменить последнюю операцию" << std::endl;
-    std::cout << "history - Показать историю операций" << std::endl;
-    std::cout << "exit - Выход из программы" << std::endl;
+// Умножение блоков [first, last) на k с суммами до и после за тот же проход.
+// Блоки, общие с версиями истории, копируются перед записью; нулевые
+// не трогаются, а при k = 0 блоки не переписываются, а заменяются общим
+// нулевым. При k = 1 массив только читается.
+MultiplyResult multiplyChunks(ChunkedArray& arr, int k, MultiplicationStrategy& strategy,
+                              size_t first, size_t last) {
+    MultiplyResult total;
+    if (k == 0 || k == 1) {
+        total.oldSum = sumChunks(arr, first, last);
+        total.newSum = k == 0 ? 0 : total.oldSum;
+        for (size_t i = first; k == 0 && i < last; i++) {
+            arr.setZero(i);
+        }
+        return total;
+    }
+    arr.forEachWritableRun(first, last, [&](ArrayView<int> run) {
+        MultiplyResult part;
+        // k = -1, 2^n — без умножения, остальное — стратегия
+        if (!multiplySpecialWithSum(run, k, nullptr, part)) {
+            part = strategy.multiplyWithSum(run, k, nullptr);
+        }
+        total.oldSum += part.oldSum;
+        total.newSum += part.newSum;
+    });
+    return total;
 }
 
+// Отменённая операция, которую можно повторить (redo). Для необратимой
+// операции хранится и версия массива после неё: повтор возвращает её
+// без пересчёта, а обратимая операция просто умножается заново.
+struct RedoEntry {
+    OperationHistory operation;
+    std::optional<ChunkedArray::Version> resultState;
+};
+
 // Контекст, который использует стратегию
 class ArrayMultiplier {
 private:
-    std::unique_ptr<MultiplicationStrategy> strategy;
+    // Текущая стратегия со всем, что к ней относится. Фоновая операция
+    // получает свою копию, поэтому смена стратегии её не затрагивает.
+    struct StrategyState {
+        std::shared_ptr<MultiplicationStrategy> strategy;
+        StrategyFactory::StrategyType type = StrategyFactory::LOOP;
+        std::string name;  // getName() один раз в setStrategy, а не на каждую операцию
+        TimingStats* multiplyStats = nullptr;
+        TimingStats* saveHistoryStats = nullptr;
+    };
+    StrategyState current;
+
+    // Версии в истории делят блоки с массивом, поэтому глубина ограничена
+    // не числом полных копий, а памятью копий блоков, которые держат только
+    // версии (MAX_SNAPSHOT_BYTES): при превышении вытесняются самые старые записи
     std::deque<OperationHistory> history;
-    const size_t MAX_HISTORY = 10;
+    std::vector<RedoEntry> redoStack;  // последняя отменённая операция — в конце
+    static const size_t MAX_HISTORY = 4096;
+    static const size_t MAX_SNAPSHOT_BYTES = size_t(1) << 30;
+    static const size_t HISTORY_PRINT_LIMIT = 20;
+
+    // Время операций по стратегиям. Счётчики стратегии берутся один раз
+    // в setStrategy, чтобы замер не искал их на каждом вызове.
+    OperationStats stats;
+
+    // Сообщения о работе уходят приёмнику событий; по умолчанию — никуда
+    NullEventSink noEvents;
+    EventSink* events = &noEvents;
+
+    // Журнал на диске (--journal). journaledEntries — сколько последних записей
+    // истории записаны в журнал после его контрольной точки: только их отмену
+    // можно записать как UNDO, иначе после отмены пишется новая контрольная точка.
+    OperationJournal* journal = nullptr;
+    size_t journaledEntries = 0;
+
+    // Фоновые умножения (multiplyArrayAsync) выполняет один поток по очереди.
+    // Пока очередь не пуста, массив и всё состояние контекста принадлежат
+    // этому потоку: остальные методы сначала дожидаются её (waitIdle).
+    // События фонового потока копятся в workerEvents и передаются приёмнику
+    // из потока REPL (deliverEvents), потому что emit() вызывает один поток.
+    static const size_t STEP_CHUNKS = 16;  // блоков в группе: проверка диапазона и отмены
+
+    struct AsyncJob {
+        ChunkedArray* arr;
+        int k;
+        StrategyState target;
+        std::shared_ptr<OperationProgress> progress;
+        std::promise<AsyncMultiplyResult> promise;
+    };
+
+    std::thread worker;
+    std::mutex queueMutex;
+    std::condition_variable queueChanged;
+    std::condition_variable queueIdle;
+    std::deque<AsyncJob> queue;
+    std::shared_ptr<OperationProgress> running;  // выполняемая операция
+    std::vector<StrategyEvent> workerEvents;
+    bool stopping = false;
+
+    // with — стратегия для отложенного множителя (см. applyPending)
+    void checkpointIfDue(ChunkedArray& arr, MultiplicationStrategy& with) {
+        if (journal->checkpointDue()) {
+            writeCheckpoint(arr, with);
+        }
+    }
+
+    void writeCheckpoint(ChunkedArray& arr, MultiplicationStrategy& with) {
+        applyPending(arr, with);
+        journal->checkpoint(arr);
+        journaledEntries = 0;
+    }
+
+    // Вытесняет самую старую запись; её версия освобождает блоки,
+    // на которые больше никто не ссылается
+    void dropOldestEntry() {
+        history.pop_front();
+        pendingOps = std::min(pendingOps, history.size());
+        journaledEntries = std::min(journaledEntries, history.size());
+    }
+
+    // Копии блоков, которые держат только версии истории и redo
+    static size_t snapshotBytes(const ChunkedArray& arr) {
+        return ChunkedArray::heapBytes() - arr.ownedBytes();
+    }
+
+    // После операции со снимком: вытесняет старые записи, пока копии
+    // блоков в версиях не уложатся в MAX_SNAPSHOT_BYTES
+    void trimSnapshots(const ChunkedArray& arr) {
+        while (history.size() > 1 && snapshotBytes(arr) > MAX_SNAPSHOT_BYTES) {
+            dropOldestEntry();
+        }
+    }
+
+    // Ленивый режим: подряд идущие умножения копятся в pendingFactor и
+    // применяются к массиву одним проходом при первом чтении (materialize).
+    // Все отложенные операции точно обратимы, поэтому сумма и диапазон
+    // значений вычисляются из кэша базового массива без обхода данных.
+    bool lazyMode = false;
+    long long pendingFactor = 1;
+    size_t pendingOps = 0;          // последние pendingOps записей истории ещё не применены
+    bool baseValid = false;         // кэш ниже описывает текущее содержимое массива
+    const ChunkedArray* baseArray = nullptr;
+    long long baseSum = 0;
+    ValueRange baseRange;
+
+    void cacheBase(const ChunkedArray& arr) {
+        if (baseValid && baseArray == &arr) {
+            return;
+        }
+        if (pendingOps > 0) {
+            throw std::logic_error("Отложенные операции относятся к другому массиву");
+        }
+        baseArray = &arr;
+        baseSum = sumArray(arr);
+        baseRange = findValueRange(arr);
+        baseValid = true;
+    }
+
+    // Пытается отложить умножение; false — операцию нужно выполнить сразу.
+    // Суммы до и после считаются из кэша и возвращаются в result.
+    bool deferMultiply(const ChunkedArray& arr, int k, MultiplyResult& result) {
+        if (k == 0) {
+            return false;
+        }
+        cacheBase(arr);
+        long long factor;
+        if (__builtin_mul_overflow(pendingFactor, static_cast<long long>(k), &factor) ||
+            !fitsAfterMultiply(baseRange, factor)) {
+            return false;
+        }
+
+        if (history.size() >= MAX_HISTORY) {
+            dropOldestEntry();
+        }
+        history.emplace_back(current.name, current.type, k);
+        pendingOps++;
+
+        result.oldSum = baseSum * pendingFactor;
+        pendingFactor = factor;
+        result.newSum = baseSum * pendingFactor;
+        return true;
+    }
+
+    // Применяет накопленный множитель одним проходом стратегией with.
+    // Стратегию передаёт вызывающий: фоновый поток не читает current,
+    // который поток REPL может заменить во время операции.
+    void applyPending(ChunkedArray& arr, MultiplicationStrategy& with) {
+        if (pendingOps == 0 && pendingFactor == 1) {
+            return;
+        }
+        // Если factor не помещается в int, все элементы нулевые (см. fitsAfterMultiply),
+        // и умножение на младшие 32 бита даёт тот же результат
+        int factor = static_cast<int>(static_cast<unsigned long long>(pendingFactor));
+        if (factor != 1) {
+            arr.forEachWritableRun([&](ArrayView<int> run) {
+                if (!multiplySpecial(run, factor)) {
+                    with.multiply(run, factor);
+                }
+            });
+        }
+        baseSum *= pendingFactor;
+        if (pendingFactor < 0) {
+            std::swap(baseRange.min, baseRange.max);
+        }
+        baseRange.min = static_cast<int>(baseRange.min * pendingFactor);
+        baseRange.max = static_cast<int>(baseRange.max * pendingFactor);
+        pendingFactor = 1;
+        pendingOps = 0;
+    }
+
+    // Добавляет запись истории. Для необратимых операций она запоминает
+    // версию массива: ссылки на блоки, без копирования данных.
+    // Возвращает true, если версия сохранена.
+    bool pushHistory(const ChunkedArray& arr, int k, const StrategyState& target, bool invertible) {
+        if (history.size() >= MAX_HISTORY) {
+            dropOldestEntry();
+        }
+        if (invertible) {
+            history.emplace_back(target.name, target.type, k);
+            return false;
+        }
+        history.emplace_back(target.name, target.type, k, arr.version());
+        return true;
+    }
+
+    // Возвращает массив к состоянию до операции entry, которая успела
+    // изменить блоки [0, chunks): необратимая — к сохранённой версии,
+    // обратимая — делением этих блоков
+    void revertOperation(ChunkedArray& arr, const OperationHistory& entry, size_t chunks) {
+        if (entry.hasSnapshot()) {
+            arr.restore(*entry.previousState);
+        } else {
+            arr.forEachWritableRun(0, chunks, [&](ArrayView<int> run) {
+                divideArrayExact(run, entry.multiplier);
+            });
+        }
+        baseValid = false;
+    }
+
+    // Событие из фонового потока или при занятой очереди — в буфер,
+    // иначе сразу приёмнику
+    void post(const StrategyEvent& event) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        workerEvents.push_back(event);
+    }
+
+    void emitNowOrQueued(const StrategyEvent& event) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (!queue.empty() || running) {
+                workerEvents.push_back(event);
+                return;
+            }
+        }
+        deliverEvents();
+        events->emit(event);
+    }
+
+    void workerLoop() {
+        while (true) {
+            AsyncJob job;
+            {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                queueChanged.wait(lock, [&] { return stopping || !queue.empty(); });
+                if (queue.empty()) {
+                    return;
+                }
+                job = std::move(queue.front());
+                queue.pop_front();
+                running = job.progress;
+            }
+            try {
+                job.promise.set_value(runAsyncJob(job));
+            } catch (...) {
+                job.promise.set_exception(std::current_exception());
+            }
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                running.reset();
+            }
+            queueIdle.notify_all();
+        }
+    }
+
+    // Умножение с записью истории, без отдельного прохода для проверки
+    // обратимости. Нечётное k обратимо всегда. Для чётного k диапазон каждой
+    // группы из STEP_CHUNKS блоков проверяется прямо перед её умножением,
+    // пока группа ещё в кэше. Если группа переполнится, уже умноженные блоки
+    // делятся обратно, запись истории получает версию массива, и умножение
+    // начинается заново. С progress между группами проверяется отмена.
+    // Возвращает число умноженных блоков: меньше chunkCount() при отмене.
+    size_t multiplyRecorded(ChunkedArray& arr, int k, const StrategyState& target,
+                            OperationProgress* progress, MultiplyResult& sums, bool& snapshot) {
+        {
+            ScopedTimer timer(target.saveHistoryStats, arr.size());
+            // k = 0 сохраняет версию: нулевые блоки не копируются
+            snapshot = pushHistory(arr, k, target, k != 0);
+        }
+        bool checkRange = k != 0 && !isAlwaysInvertible(k);
+        size_t chunks = arr.chunkCount();
+        if (!progress && !checkRange) {
+            sums = multiplyChunks(arr, k, *target.strategy, 0, chunks);
+            return chunks;
+        }
+
+        sums = MultiplyResult();
+        size_t done = 0;
+        size_t reported = 0;
+        while (done < chunks && !(progress && progress->isCancelled())) {
+            size_t next = std::min(chunks, done + STEP_CHUNKS);
+            if (checkRange && !fitsAfterMultiply(findValueRange(arr, done, next), k)) {
+                arr.forEachWritableRun(0, done, [&](ArrayView<int> run) {
+                    divideArrayExact(run, k);
+                });
+                history.back().previousState = arr.version();
+                snapshot = true;
+                checkRange = false;
+                sums = MultiplyResult();
+                done = 0;
+                continue;
+            }
+            MultiplyResult part = multiplyChunks(arr, k, *target.strategy, done, next);
+            sums.oldSum += part.oldSum;
+            sums.newSum += part.newSum;
+            if (progress && next > reported) {
+                progress->advance(next - reported);
+                reported = next;
+            }
+            done = next;
+        }
+        return done;
+    }
+
+    // Тело фоновой операции (в потоке worker). Блоки обрабатываются группами
+    // по STEP_CHUNKS, между группами проверяется отмена. Отменённая
+    // операция откатывается как undo: запись истории уже сделана, поэтому
+    // revertOperation возвращает изменённые блоки, а запись снимается.
+    AsyncMultiplyResult runAsyncJob(AsyncJob& job) {
+        ChunkedArray& arr = *job.arr;
+        OperationProgress& progress = *job.progress;
+        AsyncMultiplyResult outcome;
+
+        StrategyEvent event(EventType::MULTIPLIED, job.target.name);
+        event.multiplier = job.k;
+        if (progress.isCancelled()) {
+            // Отменена в очереди: массив не трогали
+            event.type = EventType::CANCELLED;
+            post(event);
+            outcome.cancelled = true;
+            return outcome;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        size_t chunks = arr.chunkCount();
+        progress.start(chunks);
+        if (journal) {
+            journal->logMultiply(job.target.type, job.k);
+        }
+        applyPending(arr, *job.target.strategy);
+        bool snapshot = false;
+        size_t done = multiplyRecorded(arr, job.k, job.target, &progress, outcome.sums, snapshot);
+        baseValid = false;
+
+        if (done < chunks) {
+            revertOperation(arr, history.back(), done);
+            history.pop_back();
+            if (journal) {
+                journal->logUndo();
+                checkpointIfDue(arr, *job.target.strategy);
+            }
+            event.type = EventType::CANCELLED;
+            event.elements = std::min(arr.size(), done * ChunkedArray::CHUNK_ELEMENTS);
+            post(event);
+            outcome.cancelled = true;
+            outcome.sums = MultiplyResult();
+            return outcome;
+        }
+
+        // Операция завершена: как у multiplyArray, новая операция обрывает redo
+        redoStack.clear();
+        if (snapshot) {
+            trimSnapshots(arr);
+        }
+        if (job.target.multiplyStats) {
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            job.target.multiplyStats->record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()), arr.size());
+        }
+        event.elements = arr.size();
+        event.oldSum = outcome.sums.oldSum;
+        event.newSum = outcome.sums.newSum;
+        post(event);
+        if (journal) {
+            journaledEntries = std::min(journaledEntries + 1, history.size());
+            checkpointIfDue(arr, *job.target.strategy);
+        }
+        return outcome;
+    }
     
 public:
-    void setStrategy(std::unique_ptr<MultiplicationStrategy> newStrategy) {
-        strategy = std::move(newStrategy);
-        if (strategy) {
-            std::cout << "✓ Применена стратегия: " << strategy->getName() << std::endl;
+    ArrayMultiplier() = default;
+    ArrayMultiplier(const ArrayMultiplier&) = delete;
+    ArrayMultiplier& operator=(const ArrayMultiplier&) = delete;
+
+    // Невыполненные фоновые операции отменяются
+    ~ArrayMultiplier() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopping = true;
+            for (AsyncJob& job : queue) {
+                job.progress->cancel();
+            }
+            if (running) {
+                running->cancel();
+            }
+        }
+        queueChanged.notify_all();
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    void setEventSink(EventSink& sink) {
+        waitIdle();
+        events = &sink;
+    }
+
+    // Вызывается до первой операции или сразу после восстановления из этого
+    // же журнала: тогда вся история — операции после его контрольной точки
+    void setJournal(OperationJournal* newJournal) {
+        waitIdle();
+        journal = newJournal;
+        journaledEntries = history.size();
+    }
+
+    // type — номер стратегии для журнала. Фоновые операции в очереди
+    // выполняются стратегией, которая была текущей при их запуске.
+    void setStrategy(std::unique_ptr<MultiplicationStrategy> newStrategy, StrategyFactory::StrategyType type) {
+        current.strategy = std::move(newStrategy);
+        current.type = type;
+        if (current.strategy) {
+            current.name = current.strategy->getName();
+            current.multiplyStats = &stats.slot(Operation::MULTIPLY, current.name);
+            current.saveHistoryStats = &stats.slot(Operation::SAVE_HISTORY, current.name);
+            emitNowOrQueued(StrategyEvent(EventType::STRATEGY_CHANGED, current.name));
         }
     }
     
-    void multiplyArray(std::vector<int>& arr, int k) {
-        if (strategy) {
-            saveHistory(arr, k);
-            int oldSum = sumArrayWithPointers(arr);
-            strategy->multiply(arr, k);
-            int newSum = sumArrayWithPointers(arr);
-            std::cout << "Сумма до: " << oldSum << " → Сумма после: " << newSum << std::endl;
+    // Один проход по памяти: умножение и обе суммы. Снимок для undo — версия
+    // массива, поэтому копируются только блоки, которые операция изменит.
+    void multiplyArray(ChunkedArray& arr, int k) {
+        if (current.strategy) {
+            waitIdle();
+            // Запись в журнал — до изменения массива (write-ahead)
+            if (journal) {
+                journal->logMultiply(current.type, k);
+            }
+            // Новая операция обрывает цепочку redo
+            redoStack.clear();
+            // Событие — вне замера: время приёмника не относится к стратегии
+            MultiplyResult result;
+            bool deferred;
+            {
+                ScopedTimer timer(current.multiplyStats, arr.size());
+                deferred = lazyMode && deferMultiply(arr, k, result);
+                if (!deferred) {
+                    applyPending(arr, activeStrategy());
+                    bool snapshot = false;
+                    multiplyRecorded(arr, k, current, nullptr, result, snapshot);
+                    baseValid = false;
+                    if (snapshot) {
+                        trimSnapshots(arr);
+                    }
+                }
+            }
+            StrategyEvent event(EventType::MULTIPLIED, current.name);
+            event.multiplier = k;
+            event.elements = arr.size();
+            event.oldSum = result.oldSum;
+            event.newSum = result.newSum;
+            event.deferred = deferred;
+            events->emit(event);
+            if (journal) {
+                journaledEntries = std::min(journaledEntries + 1, history.size());
+                checkpointIfDue(arr, activeStrategy());
+            }
         } else {
             throw std::runtime_error("Стратегия не установлена!");
         }
     }
+
+    // Умножение в фоновом потоке текущей стратегией. Операции выполняются
+    // по очереди в порядке запуска; прогресс и отмена — через progress,
+    // итог — через result. Отменённая операция откатывается и не остаётся
+    // в истории. Ленивый режим к фоновым операциям не применяется.
+    AsyncMultiply multiplyArrayAsync(ChunkedArray& arr, int k) {
+        if (!current.strategy) {
+            throw std::runtime_error("Стратегия не установлена!");
+        }
+        AsyncJob job{&arr, k, current, std::make_shared<OperationProgress>(), {}};
+        AsyncMultiply handle{job.promise.get_future().share(), job.progress};
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            queue.push_back(std::move(job));
+            if (!worker.joinable()) {
+                worker = std::thread(&ArrayMultiplier::workerLoop, this);
+            }
+        }
+        queueChanged.notify_one();
+        return handle;
+    }
+
+    // Есть ли невыполненные фоновые операции
+    bool isBusy() {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        return !queue.empty() || running;
+    }
+
+    // Дожидается всех фоновых операций и передаёт их события приёмнику
+    void waitIdle() {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueIdle.wait(lock, [&] { return queue.empty() && !running; });
+        }
+        deliverEvents();
+    }
+
+    // Передаёт приёмнику события, накопленные фоновым потоком.
+    // Вызывается из потока, который владеет приёмником.
+    void deliverEvents() {
+        std::vector<StrategyEvent> ready;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            ready.swap(workerEvents);
+        }
+        if (ready.empty()) {
+            return;
+        }
+        for (const StrategyEvent& event : ready) {
+            events->emit(event);
+        }
+        // Асинхронный приёмник пишет в std::cout из своего потока: пока он
+        // не закончит, вызывающий не должен печатать сам
+        events->flush();
+    }
     
-    void saveHistory(const std::vector<int>& arr, int k) {
-        if (history.size() >= MAX_HISTORY) {
-            history.pop_front();
+    // Применяет накопленный множитель одним проходом. Вызывается перед любым
+    // чтением элементов массива (вывод, экспорт).
+    void materialize(ChunkedArray& arr) {
+        waitIdle();
+        applyPending(arr, activeStrategy());
+    }
+    
+    // Элемент с учётом отложенного множителя — без материализации массива.
+    // Только когда фоновых операций нет (isBusy() == false).
+    int elementAt(const ChunkedArray& arr, size_t i) const {
+        return static_cast<int>(arr.at(i) * pendingFactor);
+    }
+    
+    // Сумма элементов; в ленивом режиме — из кэша без обхода массива
+    long long sum(const ChunkedArray& arr) {
+        waitIdle();
+        if (lazyMode) {
+            cacheBase(arr);
+            return baseSum * pendingFactor;
+        }
+        return sumArray(arr);
+    }
+    
+    void setLazyMode(ChunkedArray& arr, bool enabled) {
+        waitIdle();
+        if (!enabled) {
+            applyPending(arr, activeStrategy());
         }
-        history.emplace_back(strategy->getName(), k, arr);
+        lazyMode = enabled;
     }
     
-    bool undo(std::vector<int>& arr) {
+    bool isLazy() const {
+        return lazyMode;
+    }
+    
+    bool undo(ChunkedArray& arr) {
+        waitIdle();
         if (history.empty()) {
-            std::cout << "❌ Нет операций для отмены" << std::endl;
+            events->emit(StrategyEvent(EventType::NOTHING_TO_UNDO, ""));
             return false;
         }
+        // Отмена операции из журнала записывается заранее; отмена более ранней
+        // (до контрольной точки) в журнале невыразима — после неё пишется
+        // новая контрольная точка
+        bool undoJournaled = journal && journaledEntries > 0;
+        if (undoJournaled) {
+            journal->logUndo();
+            journaledEntries--;
+        }
         
-        const auto& lastOp = history.back();
-        arr = lastOp.previousState;
-        std::cout << "✓ Отменена операция: " << lastOp.strategyName 
-                  << " с множителем " << lastOp.multiplier << std::endl;
+        OperationHistory& lastOp = history.back();
+        std::optional<ChunkedArray::Version> resultState;
+        {
+            ScopedTimer timer(&stats.slot(Operation::UNDO, lastOp.strategyName), arr.size());
+            if (pendingOps > 0) {
+                // Отложенная операция ещё не трогала массив
+                pendingFactor /= lastOp.multiplier;
+                pendingOps--;
+            } else {
+                if (lastOp.hasSnapshot()) {
+                    resultState = arr.version();
+                }
+                revertOperation(arr, lastOp, arr.chunkCount());
+            }
+        }
+        StrategyEvent event(EventType::UNDONE, lastOp.strategyName);
+        event.multiplier = lastOp.multiplier;
+        event.elements = arr.size();
+        events->emit(event);
+        redoStack.push_back({std::move(lastOp), std::move(resultState)});
         history.pop_back();
+        if (journal) {
+            if (undoJournaled) {
+                checkpointIfDue(arr, activeStrategy());
+            } else {
+                writeCheckpoint(arr, activeStrategy());
+            }
+        }
+        return true;
+    }
+
+    // Повторяет последнюю отменённую операцию. Необратимая возвращается
+    // к сохранённой версии, обратимая умножается заново текущей стратегией
+    // (результат от стратегии не зависит). В журнал повтор пишется как
+    // обычное умножение той же стратегией.
+    bool redo(ChunkedArray& arr) {
+        waitIdle();
+        if (redoStack.empty()) {
+            events->emit(StrategyEvent(EventType::NOTHING_TO_REDO, ""));
+            return false;
+        }
+        RedoEntry& next = redoStack.back();
+        const int k = next.operation.multiplier;
+        if (journal) {
+            journal->logMultiply(static_cast<StrategyFactory::StrategyType>(next.operation.strategyType), k);
+        }
+        {
+            ScopedTimer timer(&stats.slot(Operation::REDO, next.operation.strategyName), arr.size());
+            applyPending(arr, activeStrategy());
+            if (next.resultState) {
+                arr.restore(*next.resultState);
+            } else {
+                multiplyChunks(arr, k, activeStrategy(), 0, arr.chunkCount());
+            }
+            baseValid = false;
+        }
+        StrategyEvent event(EventType::REDONE, next.operation.strategyName);
+        event.multiplier = k;
+        event.elements = arr.size();
+        events->emit(event);
+        if (history.size() >= MAX_HISTORY) {
+            dropOldestEntry();
+        }
+        history.push_back(std::move(next.operation));
+        redoStack.pop_back();
+        if (journal) {
+            journaledEntries = std::min(journaledEntries + 1, history.size());
+            checkpointIfDue(arr, activeStrategy());
+        }
         return true;
     }
     
-    void printHistory() const {
+    void printHistory(const ChunkedArray& arr) {
+        waitIdle();
         if (history.empty()) {
-            std::cout << "История операций пуста" << std::endl;
-            return;
+            std::cout << "История операций пуста" << "\n";
+        } else {
+            std::cout << "\n=== ИСТОРИЯ ОПЕРАЦИЙ ===" << "\n";
+            // Длинная история — только последние записи
+            size_t first = history.size() > HISTORY_PRINT_LIMIT ? history.size() - HISTORY_PRINT_LIMIT : 0;
+            if (first > 0) {
+                std::cout << "… ещё " << first << " более ранних" << "\n";
+            }
+            for (size_t i = first; i < history.size(); i++) {
+                const auto& op = history[i];
+                std::cout << i + 1 << ". " << op.strategyName
+                          << " (k=" << op.multiplier << ")"
+                          << (op.hasSnapshot() ? " [снимок]" : "")
+                          << (i + pendingOps >= history.size() ? " [отложено]" : "") << "\n";
+            }
         }
-        
-        std::cout << "\n=== ИСТОРИЯ ОПЕРАЦИЙ ===" << std::endl;
-        for (size_t i = 0; i < history.size(); i++) {
-            const auto& op = history[i];
-            std::cout << i + 1 << ". " << op.strategyName 
-                      << " (k=" << op.multiplier << ")" << std::endl;
+        if (!redoStack.empty()) {
+            std::cout << "Можно повторить (redo): " << redoStack.size() << "\n";
+        }
+        size_t bytes = snapshotBytes(arr);
+        if (bytes > 0) {
+            std::cout << "Копии блоков в снимках: " << bytes / 1024 << " КиБ" << "\n";
         }
     }
     
     bool hasStrategy() const {
-        return strategy != nullptr;
+        return current.strategy != nullptr;
+    }
+
+    const std::string& getStrategyName() const {
+        return current.name;
     }
     
-    size_t getHistorySize() const {
+    size_t getHistorySize() {
+        waitIdle();
         return history.size();
     }
+
+    size_t getRedoSize() {
+        waitIdle();
+        return redoStack.size();
+    }
+
+    const OperationStats& getStats() {
+        waitIdle();
+        return stats;
+    }
+
+private:
+    static MultiplicationStrategy& fallbackStrategy() {
+        static LoopMultiplication loop;
+        return loop;
+    }
+
+    // Текущая стратегия — только из потока REPL
+    MultiplicationStrategy& activeStrategy() {
+        return current.strategy ? *current.strategy : fallbackStrategy();
+    }
 };
 
 // Вспомогательные функции
-int sumArrayWithPointers(const std::vector<int>& arr) {
+long long sumArrayWithPointers(ArrayView<const int> arr) {
     const int* ptr = arr.data();
     const int* end = ptr + arr.size();
-    int sum = 0;
+    long long sum = 0;
     
     while (ptr < end) {
         sum += *ptr;
@@ -174,16 +873,40 @@ int sumArrayWithPointers(const std::vector<int>& arr) {
     return sum;
 }
 
-void printArray(const std::vector<int>& arr, const std::string& label = "Массив") {
-    std::cout << label << ": [ ";
-    for (size_t i = 0; i < arr.size(); i++) {
-        std::cout << arr[i];
-        if (i < arr.size() - 1) std::cout << " ";
+// Массивы длиннее PREVIEW_LIMIT в REPL печатаются сокращённо
+const size_t PREVIEW_LIMIT = 40;
+const size_t PREVIEW_EDGE = 10;
+
+void printArray(const ChunkedArray& arr, const std::string& label = "Массив") {
+    ArrayFormatter formatter(std::cout);
+    formatter.append(label).append(": [ ");
+    bool first = true;
+    arr.forEachRun([&](ArrayView<const int> run) {
+        if (!first) {
+            formatter.append(" ");
+        }
+        formatter.appendArray(run.data(), run.size(), " ");
+        first = false;
+    });
+    formatter.append(" ]\n");
+}
+
+// Текущий массив для REPL: короткий — целиком, длинный — первые и последние
+// элементы. Сокращённый вывод не материализует отложенные умножения.
+void printCurrentArray(ArrayMultiplier& multiplier, ChunkedArray& arr) {
+    if (arr.size() <= PREVIEW_LIMIT) {
+        multiplier.materialize(arr);
+        printArray(arr, "Текущий массив");
+        return;
     }
-    std::cout << " ]" << std::endl;
+    ArrayFormatter formatter(std::cout);
+    formatter.append("Текущий массив: [ ")
+             .appendPreview(arr.size(), PREVIEW_EDGE, " ",
+                            [&](size_t i) { return multiplier.elementAt(arr, i); })
+             .append(" ]\n");
 }
 
-std::vector<int> inputArray() {
+AlignedBuffer<int> inputArray() {
     int n;
     std::cout << "Введите количество элементов массива: ";
     std::cin >> n;
@@ -192,34 +915,550 @@ std::vector<int> inputArray() {
         throw std::invalid_argument("Размер массива должен быть больше 0");
     }
     
-    std::vector<int> arr(n);
-    std::cout << "Введите " << n << " элементов массива:" << std::endl;
+    AlignedBuffer<int> arr(static_cast<size_t>(n));
+    std::cout << "Введите " << n << " элементов массива:" << "\n";
     
     for (int i = 0; i < n; i++) {
-        std::cout << "Элемент " << i + 1 << ": ";
-        std::cin >> arr[i];
+        if (!(std::cin >> arr[i])) {
+            throw std::runtime_error("Ошибка ввода данных");
+        }
     }
     
     return arr;
 }
 
+// Параметры командной строки
+struct ProgramOptions {
+    std::string loadPath;     // --load <файл>: массив из текстового файла
+    size_t generateSize = 0;  // --generate <n>: синтетический массив из n элементов
+    std::string openPath;     // --open <файл>: двоичный файл массива, отображённый в память
+    bool verify = false;      // --verify: проверить контрольную сумму файла при открытии
+    std::string statsJsonPath; // --stats-json <файл>: статистика операций в JSON при выходе
+    std::string events;        // --events <console|async|null>: как показывать сообщения
+                               // (по умолчанию console, в режиме --script — null)
+    std::string scriptPath;    // --script <файл>: выполнить команды из файла без меню
+    std::string scriptTimingsPath;  // --script-timings <файл>: время каждой команды в CSV
+    std::string journalPath;   // --journal <файл>: журнал операций на диске, восстановление при запуске
+    size_t checkpointEvery = OperationJournal::DEFAULT_CHECKPOINT_EVERY;  // --checkpoint-every <записей>
+
+    // Потоковый режим: --stream <вход> --output <выход> --multiplier <k>
+    std::string streamPath;
+    std::string outputPath;
+    std::string streamStrategy = "auto";  // --strategy <номер|auto>
+    std::string streamMultiplier;         // --multiplier <k> в типе элементов файла
+    size_t chunkElements = DEFAULT_STREAM_CHUNK;  // --chunk <элементов>
+};
+
+bool hasJournalToResume(const ProgramOptions& options) {
+    return !options.journalPath.empty() && OperationJournal::exists(options.journalPath);
+}
+
+// Размер из командной строки: целое больше нуля. std::stoull сам принял бы
+// "-5" (и превратил бы его в огромное число) и "12abc".
+size_t parsePositiveSize(const std::string& option, const std::string& value) {
+    size_t parsed = 0;
+    size_t used = 0;
+    try {
+        if (!value.empty() && std::isdigit(static_cast<unsigned char>(value[0]))) {
+            parsed = std::stoull(value, &used);
+        }
+    } catch (const std::out_of_range&) {
+        used = 0;
+    }
+    if (used == 0 || used != value.size() || parsed == 0) {
+        throw std::invalid_argument(option + ": ожидается целое число больше 0, получено \"" + value + "\"");
+    }
+    return parsed;
+}
+
+ProgramOptions parseProgramOptions(int argc, char** argv) {
+    ProgramOptions options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--verify") {
+            options.verify = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Не указано значение для " + arg);
+        }
+        std::string value = argv[++i];
+        if (arg == "--load") {
+            options.loadPath = value;
+        } else if (arg == "--generate") {
+            options.generateSize = parsePositiveSize(arg, value);
+        } else if (arg == "--open") {
+            options.openPath = value;
+        } else if (arg == "--stats-json") {
+            options.statsJsonPath = value;
+        } else if (arg == "--events") {
+            options.events = value;
+        } else if (arg == "--script") {
+            options.scriptPath = value;
+        } else if (arg == "--script-timings") {
+            options.scriptTimingsPath = value;
+        } else if (arg == "--journal") {
+            options.journalPath = value;
+        } else if (arg == "--checkpoint-every") {
+            options.checkpointEvery = parsePositiveSize(arg, value);
+        } else if (arg == "--stream") {
+            options.streamPath = value;
+        } else if (arg == "--output") {
+            options.outputPath = value;
+        } else if (arg == "--strategy") {
+            options.streamStrategy = value;
+        } else if (arg == "--multiplier") {
+            options.streamMultiplier = value;
+        } else if (arg == "--chunk") {
+            options.chunkElements = parsePositiveSize(arg, value);
+        } else {
+            throw std::invalid_argument("Неизвестный параметр: " + arg);
+        }
+    }
+    if (options.events.empty()) {
+        options.events = options.scriptPath.empty() ? "console" : "null";
+    }
+    if (options.events != "console" && options.events != "async" && options.events != "null") {
+        throw std::invalid_argument("--events: ожидается console, async или null");
+    }
+    if (!options.journalPath.empty() && !options.openPath.empty()) {
+        // Отображённый файл меняется на месте без журнала, и повтор операций поверх него разошёлся бы
+        throw std::invalid_argument("--journal несовместим с --open");
+    }
+    if (hasJournalToResume(options) && (!options.loadPath.empty() || options.generateSize > 0)) {
+        // Массив восстанавливается из журнала; молча отбросить заданный вход нельзя
+        throw std::invalid_argument("Журнал " + options.journalPath +
+                                    " уже существует, массив восстанавливается из него: уберите --load/--generate");
+    }
+    if (!options.scriptPath.empty() && options.loadPath.empty() && options.generateSize == 0 &&
+        options.openPath.empty() && !hasJournalToResume(options)) {
+        throw std::invalid_argument("Для --script нужен массив: --load, --generate или --open");
+    }
+    if (!options.streamPath.empty() && (options.outputPath.empty() || options.streamMultiplier.empty())) {
+        throw std::invalid_argument("Для --stream нужны --output и --multiplier");
+    }
+    // Выход открывается с усечением раньше, чем читается вход: тот же файл
+    // (в том числе через ссылку) был бы уничтожен до обработки
+    std::error_code sameFileError;
+    if (!options.streamPath.empty() && std::filesystem::exists(options.outputPath, sameFileError) &&
+        std::filesystem::equivalent(options.streamPath, options.outputPath, sameFileError)) {
+        throw std::invalid_argument("--output не может указывать на входной файл --stream: " + options.outputPath);
+    }
+    return options;
+}
+
+// Хранилище массива REPL: собственный выровненный буфер или отображённый файл.
+// Остальной код работает с ChunkedArray поверх view() и не знает, откуда данные.
+struct ArrayStorage {
+    AlignedBuffer<int> owned;
+    std::optional<MappedArray> mapped;
+
+    ArrayView<int> view() {
+        return mapped ? mapped->view() : owned.view();
+    }
+};
+
+ArrayStorage loadInitialArray(const ProgramOptions& options) {
+    ArrayStorage storage;
+    if (!options.openPath.empty()) {
+        storage.mapped = MappedArray::open(options.openPath);
+        if (!storage.mapped->wasClean()) {
+            std::cout << "⚠️ Файл не был закрыт корректно: контрольная сумма устарела" << "\n";
+        } else if (options.verify && !storage.mapped->verify()) {
+            throw std::runtime_error("Контрольная сумма файла " + options.openPath + " не совпадает");
+        }
+    } else if (!options.loadPath.empty()) {
+        storage.owned = loadArrayFile(options.loadPath);
+    } else if (options.generateSize > 0) {
+        storage.owned = generateArray(options.generateSize);
+    } else {
+        storage.owned = inputArray();
+    }
+    return storage;
+}
+
+// Множитель для потокового режима в типе элементов файла
+template <typename T>
+T parseMultiplier(const std::string& text) {
+    size_t parsed = 0;
+    T value;
+    if constexpr (std::is_floating_point<T>::value) {
+        value = static_cast<T>(std::stod(text, &parsed));
+    } else {
+        long long wide = std::stoll(text, &parsed);
+        if (wide < std::numeric_limits<T>::min() || wide > std::numeric_limits<T>::max()) {
+            throw std::out_of_range("Множитель " + text + " не помещается в тип элементов файла");
+        }
+        value = static_cast<T>(wide);
+    }
+    if (parsed != text.size()) {
+        throw std::invalid_argument("Неверный множитель: " + text);
+    }
+    return value;
+}
+
+template <typename T>
+void runTypedStream(ArrayFileReader& reader, const ProgramOptions& options) {
+    // Таблица автовыбора откалибрована на int; для других типов она служит оценкой
+    StrategyFactory::StrategyType type = options.streamStrategy == "auto"
+        ? StrategyFactory::bestType(options.chunkElements)
+        : static_cast<StrategyFactory::StrategyType>(std::stoi(options.streamStrategy));
+    auto strategy = StrategyFactory::createTyped<T>(type);
+    T k = parseMultiplier<T>(options.streamMultiplier);
+
+    std::cout << "Потоковое умножение " << options.streamPath << " → " << options.outputPath
+              << " (" << elementTypeName(reader.elementType()) << ", стратегия: " << strategy->getName()
+              << ", k = " << k << ", блок: " << options.chunkElements << " элементов)" << "\n";
+    StreamStats stats = streamMultiplyFile<T>(reader, options.outputPath, *strategy, k, options.chunkElements);
+
+    double megabytes = static_cast<double>(stats.elements * sizeof(T)) / (1024 * 1024);
+    std::cout << "✓ Обработано элементов: " << stats.elements << " (блоков: " << stats.chunks << ")" << "\n";
+    std::cout << "Время: " << stats.seconds << " с, " << megabytes / stats.seconds << " МиБ/с" << "\n";
+    std::cout << "Загрузка стадий: чтение " << stats.readSeconds << " с, умножение "
+              << stats.computeSeconds << " с, запись " << stats.writeSeconds << " с" << "\n";
+}
+
+// Потоковый режим: файл умножается блоками без загрузки в память.
+// Тип элементов берётся из заголовка файла.
+void runStreamMode(const ProgramOptions& options) {
+    ArrayFileReader reader(options.streamPath);
+    switch (reader.elementType()) {
+        case ElementType::INT32:
+            runTypedStream<int32_t>(reader, options);
+            break;
+        case ElementType::INT64:
+            runTypedStream<int64_t>(reader, options);
+            break;
+        case ElementType::FLOAT32:
+            runTypedStream<float>(reader, options);
+            break;
+        case ElementType::FLOAT64:
+            runTypedStream<double>(reader, options);
+            break;
+    }
+}
+
+// Приёмник сообщений REPL по --events
+std::unique_ptr<EventSink> makeEventSink(const std::string& kind) {
+    if (kind == "null") {
+        return std::make_unique<NullEventSink>();
+    }
+    if (kind == "async") {
+        return std::make_unique<AsyncEventSink>(std::make_unique<ConsoleEventSink>());
+    }
+    return std::make_unique<ConsoleEventSink>();
+}
+
+// Журнал операций: существующий восстанавливается (массив из контрольной точки
+// и повтор записей после неё), новый создаётся с контрольной точкой текущего массива
+std::unique_ptr<OperationJournal> openJournal(const ProgramOptions& options, ArrayStorage& storage,
+                                              ChunkedArray& arr, ArrayMultiplier& multiplier) {
+    const std::string& path = options.journalPath;
+    if (!OperationJournal::exists(path)) {
+        OperationJournal::initialize(path, arr);
+        std::cout << "✓ Создан журнал операций " << path << "\n";
+    } else {
+        OperationJournal::Recovery recovery = OperationJournal::recover(path);
+        storage.owned = std::move(recovery.array);
+        arr = ChunkedArray(storage.view());
+        for (const JournalRecord& record : recovery.records) {
+            if (record.type == JournalRecord::UNDO) {
+                multiplier.undo(arr);
+                continue;
+            }
+            auto type = static_cast<StrategyFactory::StrategyType>(record.strategy);
+            multiplier.setStrategy(StrategyFactory::create(type), type);
+            multiplier.multiplyArray(arr, record.k);
+        }
+        std::cout << "✓ Восстановлено из журнала " << path << ": " << arr.size()
+                  << " элементов, повторено операций: " << recovery.records.size() << "\n";
+        if (recovery.discardedBytes > 0) {
+            std::cout << "⚠️ Отброшен оборванный хвост журнала: " << recovery.discardedBytes << " байт" << "\n";
+        }
+    }
+    auto journal = std::make_unique<OperationJournal>(path, options.checkpointEvery);
+    multiplier.setJournal(journal.get());
+    return journal;
+}
+
+// Номер стратегии из команды: число из меню или auto (по калибровке для n элементов)
+StrategyFactory::StrategyType strategyChoice(const std::string& input, size_t n) {
+    if (input == "auto") {
+        return StrategyFactory::bestType(n);
+    }
+    return static_cast<StrategyFactory::StrategyType>(std::stoi(input));
+}
+
+// Завершение сеанса: отложенные умножения применяются, отображённый файл
+// сохраняется, статистика пишется в JSON (если задан --stats-json)
+void finishSession(ArrayMultiplier& multiplier, ChunkedArray& arr, ArrayStorage& storage,
+                   const ProgramOptions& options) {
+    if (storage.mapped) {
+        // Скопированные блоки возвращаются на свои места в файле
+        multiplier.materialize(arr);
+        arr.copyTo(storage.mapped->view());
+        storage.mapped->sync();
+        std::cout << "✓ Изменения сохранены в " << storage.mapped->path() << "\n";
+    }
+    if (!options.statsJsonPath.empty()) {
+        std::ofstream json(options.statsJsonPath);
+        multiplier.getStats().writeJson(json);
+        std::cout << (json ? "✓ Статистика сохранена в " : "❌ Не удалось записать ")
+                  << options.statsJsonPath << "\n";
+    }
+}
+
+// Команда сценария: стратегия (номер или auto) с множителем либо
+// одна из команд REPL без аргументов
+struct ScriptCommand {
+    std::string name;
+    int k = 0;
+    size_t line = 0;
+
+    bool isMultiply() const {
+        return name == "auto" || (!name.empty() && std::all_of(name.begin(), name.end(), ::isdigit));
+    }
+
+    bool isKnown() const {
+        return isMultiply() || name == "undo" || name == "redo" || name == "history" || name == "lazy" ||
+               name == "print" || name == "stats";
+    }
+};
+
+// Сценарий записан так же, как команды вводятся в REPL: лексемы через пробелы
+// и переводы строк, множитель — следующая лексема после стратегии
+// (на той же или на следующей строке). exit завершает сценарий.
+std::vector<ScriptCommand> loadScript(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Не удалось открыть сценарий " + path);
+    }
+    std::vector<ScriptCommand> commands;
+    std::string text;
+    bool expectMultiplier = false;
+    size_t line = 0;
+    while (std::getline(file, text)) {
+        line++;
+        // Комментарии после # пропускаются
+        std::istringstream tokens(text.substr(0, text.find('#')));
+        std::string token;
+        while (tokens >> token) {
+            if (expectMultiplier) {
+                size_t parsed = 0;
+                try {
+                    commands.back().k = std::stoi(token, &parsed);
+                } catch (const std::exception&) {
+                    parsed = 0;
+                }
+                if (parsed != token.size()) {
+                    throw std::invalid_argument("Сценарий, строка " + std::to_string(line) +
+                                                ": неверный множитель «" + token + "»");
+                }
+                expectMultiplier = false;
+                continue;
+            }
+            if (token == "exit") {
+                return commands;
+            }
+            ScriptCommand command;
+            command.name = token;
+            command.line = line;
+            if (!command.isKnown()) {
+                throw std::invalid_argument("Сценарий, строка " + std::to_string(line) +
+                                            ": неизвестная команда «" + token + "»");
+            }
+            commands.push_back(command);
+            expectMultiplier = command.isMultiply();
+        }
+    }
+    if (expectMultiplier) {
+        throw std::invalid_argument("Сценарий: нет множителя после «" + commands.back().name + "»");
+    }
+    return commands;
+}
+
+// Пакетный режим: команды из файла выполняются подряд без перерисовки меню
+// и массива. Время каждой команды измеряется отдельно; в конце — общее время
+// и сводка по командам (для умножений — по стратегиям).
+void runScript(ArrayMultiplier& multiplier, EventSink& events, ChunkedArray& arr, const ProgramOptions& options) {
+    using Clock = std::chrono::steady_clock;
+    std::vector<ScriptCommand> commands = loadScript(options.scriptPath);
+
+    struct Summary {
+        size_t count = 0;
+        double totalNs = 0;
+        double maxNs = 0;
+    };
+    std::map<std::string, Summary> summary;
+    std::vector<double> durations;
+    std::vector<std::string> labels;
+    durations.reserve(commands.size());
+    labels.reserve(commands.size());
+
+    auto start = Clock::now();
+    for (const ScriptCommand& command : commands) {
+        auto begin = Clock::now();
+        try {
+            if (command.name == "undo") {
+                multiplier.undo(arr);
+            } else if (command.name == "redo") {
+                multiplier.redo(arr);
+            } else if (command.name == "history") {
+                events.flush();
+                multiplier.printHistory(arr);
+            } else if (command.name == "lazy") {
+                multiplier.setLazyMode(arr, !multiplier.isLazy());
+            } else if (command.name == "print") {
+                events.flush();
+                multiplier.materialize(arr);
+                printArray(arr, "Текущий массив");
+            } else if (command.name == "stats") {
+                events.flush();
+                multiplier.getStats().print(std::cout);
+            } else {
+                StrategyFactory::StrategyType type = strategyChoice(command.name, arr.size());
+                multiplier.setStrategy(StrategyFactory::create(type), type);
+                multiplier.multiplyArray(arr, command.k);
+            }
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Сценарий, строка " + std::to_string(command.line) +
+                                     " («" + command.name + "»): " + e.what());
+        }
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+
+        labels.push_back(command.isMultiply() ? multiplier.getStrategyName() : command.name);
+        durations.push_back(ns);
+        Summary& entry = summary[labels.back()];
+        entry.count++;
+        entry.totalNs += ns;
+        entry.maxNs = std::max(entry.maxNs, ns);
+    }
+    double totalSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    events.flush();
+
+    std::cout << "✓ Выполнено команд: " << commands.size() << " за " << totalSeconds << " с" << "\n";
+    std::cout << "Сумма элементов: " << multiplier.sum(arr) << "\n";
+    std::cout << "Операций в истории: " << multiplier.getHistorySize() << "\n";
+    std::cout << "\n=== ВРЕМЯ КОМАНД ===" << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto& [label, entry] : summary) {
+        std::cout << label << ": " << entry.count << " раз, всего " << entry.totalNs / 1000
+                  << " мкс, в среднем " << entry.totalNs / entry.count / 1000
+                  << " мкс, максимум " << entry.maxNs / 1000 << " мкс" << "\n";
+    }
+    std::cout << std::defaultfloat;
+
+    if (!options.scriptTimingsPath.empty()) {
+        std::ofstream csv(options.scriptTimingsPath);
+        csv << "line,command,k,ns\n";
+        for (size_t i = 0; i < commands.size(); i++) {
+            csv << commands[i].line << ",\"" << labels[i] << "\"," << commands[i].k << ","
+                << static_cast<uint64_t>(durations[i]) << "\n";
+        }
+        std::cout << (csv ? "✓ Время команд сохранено в " : "❌ Не удалось записать ")
+                  << options.scriptTimingsPath << "\n";
+    }
+}
+
+// Фоновая операция REPL (команда bg)
+struct BackgroundJob {
+    size_t id;
+    std::string strategy;
+    int k;
+    AsyncMultiply handle;
+};
+
+// Итоги завершённых фоновых операций (они убираются из списка)
+// и прогресс остальных
+void reportBackgroundJobs(std::vector<BackgroundJob>& jobs) {
+    for (auto it = jobs.begin(); it != jobs.end();) {
+        std::cout << "Фоновая операция #" << it->id << " (" << it->strategy << ", k=" << it->k << "): ";
+        if (it->handle.result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            const OperationProgress& progress = *it->handle.progress;
+            if (!progress.isStarted()) {
+                std::cout << "в очереди" << "\n";
+            } else {
+                std::cout << static_cast<int>(progress.fraction() * 100) << "% ("
+                          << progress.completedChunks() << " из " << progress.totalChunks() << " блоков)"
+                          << (progress.isCancelled() ? ", отменяется" : "") << "\n";
+            }
+            ++it;
+            continue;
+        }
+        try {
+            AsyncMultiplyResult result = it->handle.result.get();
+            if (result.cancelled) {
+                std::cout << "отменена" << "\n";
+            } else {
+                std::cout << "завершена, сумма " << result.sums.oldSum << " → " << result.sums.newSum << "\n";
+            }
+        } catch (const std::exception& e) {
+            std::cout << "❌ ошибка: " << e.what() << "\n";
+        }
+        it = jobs.erase(it);
+    }
+}
+
 void clearInputBuffer() {
     std::cin.clear();
     std::cin.ignore(10000, '\n');
 }
 
-int main() {
+int main(int argc, char** argv) {
     try {
-        std::cout << "=== ДИНАМИЧЕСКАЯ СИСТЕМА УМНОЖЕНИЯ МАССИВОВ ===" << std::endl;
+        std::ios::sync_with_stdio(false);
+        std::cout << "=== ДИНАМИЧЕСКАЯ СИСТЕМА УМНОЖЕНИЯ МАССИВОВ ===" << "\n";
         
-        std::vector<int> arr = inputArray();
+        ProgramOptions options = parseProgramOptions(argc, argv);
+        if (!options.streamPath.empty()) {
+            runStreamMode(options);
+            return 0;
+        }
+        // При восстановлении из журнала массив берётся из его контрольной точки
+        ArrayStorage storage = hasJournalToResume(options) ? ArrayStorage() : loadInitialArray(options);
+        std::unique_ptr<EventSink> events = makeEventSink(options.events);
+        ChunkedArray arr(storage.view());
+        std::unique_ptr<OperationJournal> journal;
         ArrayMultiplier multiplier;
+        if (!options.journalPath.empty()) {
+            journal = openJournal(options, storage, arr, multiplier);
+        }
+        multiplier.setEventSink(*events);
+
+        if (!options.scriptPath.empty()) {
+            runScript(multiplier, *events, arr, options);
+            finishSession(multiplier, arr, storage, options);
+            return 0;
+        }
         
+        // Асинхронный приёмник печатает из своего потока. Перед выводом REPL
+        // и перед чтением std::cin (оно сбрасывает привязанный std::cout)
+        // его очередь должна быть пуста.
+        auto finishCommand = [&] {
+            events->flush();
+            clearInputBuffer();
+        };
+
+        std::vector<BackgroundJob> backgroundJobs;
+        size_t nextJobId = 1;
         while (true) {
-            std::cout << "\n" << std::string(50, '=') << std::endl;
-            printArray(arr, "Текущий массив");
-            std::cout << "Сумма элементов: " << sumArrayWithPointers(arr) << std::endl;
-            std::cout << "Операций в истории: " << multiplier.getHistorySize() << std::endl;
+            // Сообщения прошлой команды (и фоновых операций) выводятся
+            // до новой порции вывода REPL
+            multiplier.deliverEvents();
+            events->flush();
+            std::cout << "\n" << std::string(50, '=') << "\n";
+            reportBackgroundJobs(backgroundJobs);
+            if (multiplier.isBusy()) {
+                // Массив занят фоновым потоком: без вывода и подсчёта суммы
+                std::cout << "Массив занят фоновыми операциями (cancel — отменить, wait — дождаться)" << "\n";
+            } else {
+                printCurrentArray(multiplier, arr);
+                std::cout << "Сумма элементов: " << multiplier.sum(arr) << "\n";
+                std::cout << "Операций в истории: " << multiplier.getHistorySize() << "\n";
+                if (multiplier.getRedoSize() > 0) {
+                    std::cout << "Можно повторить (redo): " << multiplier.getRedoSize() << "\n";
+                }
+            }
             
             StrategyFactory::printAvailableStrategies();
             
@@ -227,25 +1466,106 @@ int main() {
             std::string input;
             std::cin >> input;
             
-            if (input == "exit") {
-                std::cout << "Завершение работы..." << std::endl;
+            // Команды, работающие с массивом, не ждут фоновую очередь: пока
+            // они ждали бы, нельзя было бы ввести cancel
+            bool backgroundCommand = input == "bg" || input == "cancel" || input == "wait" || input == "exit";
+            if (std::cin && !backgroundCommand && multiplier.isBusy()) {
+                std::cout << "❌ Массив занят фоновыми операциями: дождитесь их (wait) или отмените (cancel)" << "\n";
+                finishCommand();
+                continue;
+            }
+            
+            if (!std::cin || input == "exit") {
+                multiplier.waitIdle();
+                reportBackgroundJobs(backgroundJobs);
+                finishSession(multiplier, arr, storage, options);
+                std::cout << "Завершение работы..." << "\n";
                 break;
             }
             else if (input == "undo") {
                 multiplier.undo(arr);
-                clearInputBuffer();
+                finishCommand();
+                continue;
+            }
+            else if (input == "redo") {
+                multiplier.redo(arr);
+                finishCommand();
                 continue;
             }
             else if (input == "history") {
-                multiplier.printHistory();
-                clearInputBuffer();
+                multiplier.printHistory(arr);
+                finishCommand();
+                continue;
+            }
+            else if (input == "stats") {
+                multiplier.getStats().print(std::cout);
+                finishCommand();
+                continue;
+            }
+            else if (input == "print") {
+                multiplier.materialize(arr);
+                printArray(arr, "Текущий массив");
+                finishCommand();
+                continue;
+            }
+            else if (input == "export") {
+                std::string path;
+                std::cin >> path;
+                try {
+                    multiplier.materialize(arr);
+                    arr.save(path);
+                    std::cout << "✓ Массив сохранён в " << path << "\n";
+                } catch (const std::exception& e) {
+                    std::cout << "❌ Ошибка: " << e.what() << "\n";
+                }
+                finishCommand();
+                continue;
+            }
+            else if (input == "bg") {
+                // bg <стратегия> <k>: умножение в фоне, REPL продолжает принимать команды
+                std::string choice;
+                int k;
+                try {
+                    if (!(std::cin >> choice >> k)) {
+                        throw std::invalid_argument("ожидается bg <стратегия> <k>");
+                    }
+                    StrategyFactory::StrategyType type = strategyChoice(choice, arr.size());
+                    multiplier.setStrategy(StrategyFactory::create(type), type);
+                    events->flush();
+                    AsyncMultiply handle = multiplier.multiplyArrayAsync(arr, k);
+                    backgroundJobs.push_back({nextJobId, multiplier.getStrategyName(), k, handle});
+                    std::cout << "✓ Фоновая операция #" << nextJobId++ << " поставлена в очередь" << "\n";
+                } catch (const std::exception& e) {
+                    std::cout << "❌ Ошибка: " << e.what() << "\n";
+                }
+                finishCommand();
+                continue;
+            }
+            else if (input == "cancel") {
+                // Отмена всех фоновых операций: выполняемая откатывается, ждущие не начнутся
+                for (BackgroundJob& job : backgroundJobs) {
+                    job.handle.progress->cancel();
+                }
+                std::cout << "✓ Запрошена отмена фоновых операций: " << backgroundJobs.size() << "\n";
+                finishCommand();
+                continue;
+            }
+            else if (input == "wait") {
+                multiplier.waitIdle();
+                finishCommand();
+                continue;
+            }
+            else if (input == "lazy") {
+                multiplier.setLazyMode(arr, !multiplier.isLazy());
+                std::cout << "✓ Ленивый режим " << (multiplier.isLazy() ? "включён" : "выключен") << "\n";
+                finishCommand();
                 continue;
             }
             
             try {
-                int choice = std::stoi(input);
-                auto strategy = StrategyFactory::create(static_cast<StrategyFactory::StrategyType>(choice));
-                multiplier.setStrategy(std::move(strategy));
+                StrategyFactory::StrategyType type = strategyChoice(input, arr.size());
+                multiplier.setStrategy(StrategyFactory::create(type), type);
+                events->flush();
                 
                 int k;
                 std::cout << "Введите множитель k: ";
@@ -254,18 +1574,21 @@ int main() {
                 multiplier.multiplyArray(arr, k);
                 
             } catch (const std::invalid_argument&) {
-                std::cout << "❌ Ошибка: неверная команда! Попробуйте снова." << std::endl;
+                events->flush();
+                std::cout << "❌ Ошибка: неверная команда! Попробуйте снова." << "\n";
             } catch (const std::out_of_range&) {
-                std::cout << "❌ Ошибка: неверный номер стратегии!" << std::endl;
+                events->flush();
+                std::cout << "❌ Ошибка: неверный номер стратегии!" << "\n";
             } catch (const std::exception& e) {
-                std::cout << "❌ Ошибка: " << e.what() << std::endl;
+                events->flush();
+                std::cout << "❌ Ошибка: " << e.what() << "\n";
             }
             
-            clearInputBuffer();
+            finishCommand();
         }
         
     } catch (const std::exception& e) {
-        std::cout << "❌ Критическая ошибка: " << e.what() << std::endl;
+        std::cout << "❌ Критическая ошибка: " << e.what() << "\n";
         return 1;
     }
     